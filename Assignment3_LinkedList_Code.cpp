@@ -7,10 +7,25 @@
 //============================================================================
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <new>
+#include <random>
+#include <string_view>
+#include <thread>
 #include <time.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "BidBloomFilter.hpp"
 #include "CSVparser.hpp"
+#include "EpochReclamation.hpp"
 
 using namespace std;
 
@@ -32,10 +47,151 @@ struct Bid {
     }
 };
 
+//============================================================================
+// Node pool allocator definition
+//============================================================================
+
+// number of nodes in the first slab; each new slab doubles up to the max
+const size_t POOL_FIRST_SLAB = 64;
+const size_t POOL_MAX_SLAB = 65536;
+
+/**
+ * Define a class that hands out fixed-size nodes carved from large slabs.
+ * Released nodes go on a free list and are reused by the next allocation,
+ * and all slabs are returned to the heap at once when the pool is released,
+ * so a bulk load makes a few dozen allocation calls instead of one per node.
+ */
+template <typename T>
+class NodePool {
+
+private:
+    // a slot either holds a live object or links to the next free slot
+    union Slot {
+        Slot* nextFree;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    vector<Slot*> slabs;
+    Slot* freeList = nullptr;
+    Slot* slabCursor = nullptr;
+    Slot* slabEnd = nullptr;
+    size_t nextSlabSize = POOL_FIRST_SLAB;
+
+public:
+    NodePool() {}
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    virtual ~NodePool();
+
+    template <typename... Args>
+    T* Create(Args&&... args);
+    void Destroy(T* object);
+    void Release();
+    size_t SlabCount();
+};
+
+/**
+ * Destructor
+ */
+template <typename T>
+NodePool<T>::~NodePool() {
+    Release();
+}
+
+/**
+ * Construct a new object in a pooled slot
+ *
+ * @param args arguments passed to the object constructor
+ * @return pointer to the new object
+ */
+template <typename T>
+template <typename... Args>
+T* NodePool<T>::Create(Args&&... args) {
+
+    Slot* slot;
+
+    // reuse a released slot when one is available
+    if (freeList != nullptr) {
+        slot = freeList;
+        freeList = freeList->nextFree;
+    }
+    else {
+
+        // if the current slab is used up, then allocate the next one
+        if (slabCursor == slabEnd) {
+            slabCursor = static_cast<Slot*>(::operator new(nextSlabSize * sizeof(Slot)));
+            slabEnd = slabCursor + nextSlabSize;
+            slabs.push_back(slabCursor);
+
+            nextSlabSize = min(nextSlabSize * 2, POOL_MAX_SLAB);
+        }
+
+        slot = slabCursor;
+        ++slabCursor;
+    }
+
+    return new (slot->storage) T(std::forward<Args>(args)...);
+}
+
+/**
+ * Destroy an object and put its slot on the free list
+ *
+ * @param object pointer returned by Create
+ */
+template <typename T>
+void NodePool<T>::Destroy(T* object) {
+
+    object->~T();
+
+    Slot* slot = reinterpret_cast<Slot*>(object);
+    slot->nextFree = freeList;
+    freeList = slot;
+}
+
+/**
+ * Return every slab to the heap at once.
+ * Live objects must already have been destroyed.
+ */
+template <typename T>
+void NodePool<T>::Release() {
+
+    for (Slot* slab : slabs) {
+        ::operator delete(slab);
+    }
+
+    slabs.clear();
+    freeList = nullptr;
+    slabCursor = nullptr;
+    slabEnd = nullptr;
+    nextSlabSize = POOL_FIRST_SLAB;
+}
+
+/**
+ * Returns the number of slabs allocated from the heap
+ */
+template <typename T>
+size_t NodePool<T>::SlabCount() {
+    return slabs.size();
+}
+
 //============================================================================
 // Linked-List class definition
 //============================================================================
 
+// how Search reorganizes the list after a hit
+enum SearchMode {
+    SEARCH_STATIC,          // leave the list in insertion order
+    SEARCH_MOVE_TO_FRONT,   // move the found bid to the head
+    SEARCH_TRANSPOSE        // swap the found bid with its predecessor
+};
+
+// bid field used to order the list when sorting
+enum SortKey {
+    SORT_BY_TITLE,
+    SORT_BY_BIDID,
+    SORT_BY_AMOUNT
+};
+
 /**
  * Define a class containing data members and methods to
  * implement a linked-list.
@@ -47,16 +203,19 @@ private:
     struct Node {
         Bid bid;
         Node *next;
+        Node *prev;
 
         // default constructor
         Node() {
             next = nullptr;
+            prev = nullptr;
         }
 
         // initialize with a bid
         Node(Bid aBid) {
             bid = aBid;
             next = nullptr;
+            prev = nullptr;
         }
     };
 
@@ -64,18 +223,76 @@ private:
     Node* tail;
     int size = 0;
 
+    // optional side index from bidId to node for constant time lookups;
+    // keys view the id stored in the node, so no id is copied. An id held
+    // by several nodes maps to the first of them, the one a scan finds.
+    bool useIndex = false;
+    unordered_map<string_view, Node*> index;
+
+    // nodes whose id is also held by an earlier node (index mode only)
+    int duplicateIds = 0;
+
+    // helper function to locate the node holding a bid
+    Node* findNode(string_view bidId, long long* probes = nullptr);
+
+    // helper functions to unlink a node and to relink it before another
+    void unlinkNode(Node* node);
+    void insertBefore(Node* node, Node* before);
+
+    // helper functions for the merge sort
+    static bool sortsBefore(const Bid& a, const Bid& b, SortKey key);
+    static Node* splitAfter(Node* start, int count);
+    static Node* mergeRuns(Node* left, Node* right, SortKey key, Node** runTail);
+
+    // self-organizing search mode and its counters
+    SearchMode searchMode = SEARCH_STATIC;
+    long long searchHits = 0;
+    long long searchMisses = 0;
+    long long searchProbes = 0;
+
+    // slab allocator the nodes are carved from
+    NodePool<Node> pool;
+
 public:
     LinkedList();
+    LinkedList(bool indexed);
     virtual ~LinkedList();
     void Append(Bid bid);
     void Prepend(Bid bid);
     void PrintList();
     void Remove(string bidId);
     Bid Search(string bidId);
+    const Bid* Find(string_view bidId);
     int Size();
-
-
     bool Empty();
+    void Reserve(int count);
+
+    // self-organizing search controls and statistics
+    void SetSearchMode(SearchMode mode);
+    double AverageProbeLength();
+    void PrintSearchStats();
+    void ResetSearchStats();
+
+    // reorder the nodes in place by the given bid field
+    void Sort(SortKey key);
+
+    /**
+     * Resumable position in the list used for paging.
+     * Removing the bid a cursor rests on invalidates the cursor.
+     */
+    class Cursor {
+        friend class LinkedList;
+        Node* node = nullptr;
+        int position = 0;
+    public:
+        bool AtEnd() const { return node == nullptr; }
+        int Position() const { return position; }
+    };
+
+    // cursor functions for paging through the list without printing
+    Cursor Begin();
+    Cursor Seek(int position);
+    int Fetch(Cursor& cursor, int count, vector<Bid>& rows);
 };
 
 // function to return bool based on whether list size is 0 or not
@@ -94,6 +311,15 @@ LinkedList::LinkedList() {
     
 }
 
+/**
+ * Constructor for enabling the bidId side index.
+ * With the index on, Search, duplicate checks and Remove
+ * are constant time while PrintList keeps insertion order.
+ */
+LinkedList::LinkedList(bool indexed) : LinkedList() {
+    useIndex = indexed;
+}
+
 /**
  * Destructor
  */
@@ -102,22 +328,16 @@ LinkedList::~LinkedList() {
     // create pointer to the head
     Node* current = head;
 
-    // create temp pointer to hold the node we are going to delete
-    Node* temp;
-
-    // walk the list, deleting each node one at a time
+    // walk the list, destroying each bid in place;
+    // the node memory itself belongs to the pool
     while (current != nullptr) {
-
-        // copy node we are going to delete to temp
-        temp = current;
-
-        // set current to the next node
+        Node* temp = current;
         current = current->next;
-
-        // now delete temp node
-        delete temp;
-
+        temp->~Node();
     }
+
+    // now hand every slab back to the heap at once
+    pool.Release();
 }
 
 /**
@@ -126,7 +346,7 @@ LinkedList::~LinkedList() {
 void LinkedList::Append(Bid bid) {
 
     // Create new node
-    Node* newNode = new Node(bid);
+    Node* newNode = pool.Create(bid);
 
     // if their is not a head node, then the new node is the head and tail
     if (!head) {
@@ -136,10 +356,17 @@ void LinkedList::Append(Bid bid) {
 
     // else the new node is added to the end
     else {
+        newNode->prev = this->tail;
         this->tail->next = newNode;
         this->tail = newNode;
     }
 
+    // record the node in the side index (a scan would find the
+    // first of any duplicate ids, so keep an existing entry)
+    if (useIndex && !index.emplace(newNode->bid.bidId, newNode).second) {
+        duplicateIds += 1;
+    }
+
     // increment the size of the list
     this->size += 1;
 }
@@ -158,14 +385,24 @@ void LinkedList::Prepend(Bid bid) {
     }
 
     // create the new node using the new bid
-    Node* temp = new Node(bid);
+    Node* temp = pool.Create(bid);
 
     // next pointer of new node will point to current head
     temp->next = head;
+    head->prev = temp;
 
     // make new bid be the new head
     head = temp;
 
+    // record the node in the side index, re-keying any entry for the
+    // same id so the key views this node's copy of the id
+    if (useIndex) {
+        if (index.erase(temp->bid.bidId) > 0) {
+            duplicateIds += 1;
+        }
+        index.emplace(temp->bid.bidId, temp);
+    }
+
     // increment size of the list
     this->size += 1;
 
@@ -199,6 +436,96 @@ void LinkedList::PrintList() {
 
 }
 
+/**
+ * Find the node holding the specified bidId.
+ * Uses the hash index when it is enabled, otherwise scans from the head.
+ *
+ * @param bidId The bid id to search for
+ * @param probes if given, incremented by the number of nodes examined
+ * @return the node holding the bid, or nullptr if not found
+ */
+LinkedList::Node* LinkedList::findNode(string_view bidId, long long* probes) {
+
+    // constant time lookup through the side index
+    if (useIndex) {
+        if (probes != nullptr) {
+            *probes += 1;
+        }
+
+        auto found = index.find(bidId);
+        if (found == index.end()) {
+            return nullptr;
+        }
+        return found->second;
+    }
+
+    // Loop through the list. If we find the bidId,
+    // then return the node.
+    long long count = 0;
+    Node* currNode = this->head;
+    while (currNode != nullptr) {
+        ++count;
+        if (bidId == currNode->bid.bidId) {
+            break;
+        }
+
+        currNode = currNode->next;
+    }
+
+    if (probes != nullptr) {
+        *probes += count;
+    }
+
+    return currNode;
+}
+
+/**
+ * Detach a node from its neighbors, fixing head and tail
+ *
+ * @param node the node to unlink
+ */
+void LinkedList::unlinkNode(Node* node) {
+
+    // link the previous node (or head) past the node
+    if (node->prev != nullptr) {
+        node->prev->next = node->next;
+    }
+    else {
+        head = node->next;
+    }
+
+    // link the next node (or tail) back past the node
+    if (node->next != nullptr) {
+        node->next->prev = node->prev;
+    }
+    else {
+        tail = node->prev;
+    }
+
+    node->prev = nullptr;
+    node->next = nullptr;
+}
+
+/**
+ * Link a detached node in front of another node in the list
+ *
+ * @param node the detached node
+ * @param before the node that will follow it
+ */
+void LinkedList::insertBefore(Node* node, Node* before) {
+
+    node->next = before;
+    node->prev = before->prev;
+
+    if (before->prev != nullptr) {
+        before->prev->next = node;
+    }
+    else {
+        head = node;
+    }
+    before->prev = node;
+}
+
 /**
  * Remove a specified bid
  *
@@ -206,152 +533,1276 @@ void LinkedList::PrintList() {
  */
 void LinkedList::Remove(string bidId) {
 
-    // search to verify if the bid exists
-    Bid temp = Search(bidId);
-    if (temp.bidId.empty()) {
+    // locate the node to delete
+    Node* node = findNode(bidId);
+    if (node == nullptr) {
         cout << "\nBid id " << bidId << " not found\n\n";
         return;
     }
 
-    // if list empty, just return to caller as list is empty
-    if (head == nullptr)
+    // take the node out of the list
+    unlinkNode(node);
+
+    // drop the node from the side index, unless the entry belongs to
+    // another node with the same id
+    if (useIndex) {
+        auto entry = index.find(node->bid.bidId);
+        if (entry != index.end() && entry->second != node) {
+            duplicateIds -= 1;
+        }
+        else if (entry != index.end()) {
+            index.erase(entry);
+
+            // the next copy of the id, if any, is now the one a scan finds;
+            // only lists holding duplicates pay for this walk
+            if (duplicateIds > 0) {
+                for (Node* other = head; other != nullptr; other = other->next) {
+                    if (other->bid.bidId == node->bid.bidId) {
+                        index.emplace(other->bid.bidId, other);
+                        duplicateIds -= 1;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    cout << "\n\n[[ Deleted node: " << node->bid.bidId << " ]]\n";
+
+    // now return the node to the pool and set the pointer to null
+    pool.Destroy(node);
+    node = nullptr;
+
+    // decrement size to account for deletion
+    this->size -= 1;
+}
+
+/**
+ * Search for the specified bidId and return a copy of the bid
+ *
+ * @param bidId The bid id to search for
+ */
+Bid LinkedList::Search(string bidId) {
+
+    // Return an empty bid if the key is not found
+    const Bid* found = Find(bidId);
+    if (found == nullptr) {
+        return {};
+    }
+    return *found;
+}
+
+/**
+ * Find the specified bidId without copying the key or the bid.
+ * In a self-organizing mode a hit is moved toward the head,
+ * so frequently searched bids are found after fewer probes.
+ *
+ * @param bidId The bid id to search for
+ * @return the stored bid, valid until it is removed; nullptr if not found
+ */
+const Bid* LinkedList::Find(string_view bidId) {
+
+    // find the node holding the bid, counting the nodes examined
+    Node* node = findNode(bidId, &searchProbes);
+
+    if (node == nullptr) {
+        searchMisses += 1;
+        return nullptr;
+    }
+    searchHits += 1;
+
+    // move the hit toward the head based on the search mode
+    if (node != head) {
+        if (searchMode == SEARCH_MOVE_TO_FRONT) {
+            unlinkNode(node);
+            insertBefore(node, head);
+        }
+        else if (searchMode == SEARCH_TRANSPOSE) {
+            Node* before = node->prev;
+            unlinkNode(node);
+            insertBefore(node, before);
+        }
+    }
+
+    return &node->bid;
+}
+
+/**
+ * Select how Search reorganizes the list after a hit
+ *
+ * @param mode static, move-to-front or transpose
+ */
+void LinkedList::SetSearchMode(SearchMode mode) {
+    searchMode = mode;
+}
+
+/**
+ * Returns the average number of nodes examined per Search call
+ */
+double LinkedList::AverageProbeLength() {
+    long long searches = searchHits + searchMisses;
+    if (searches == 0) {
+        return 0.0;
+    }
+    return searchProbes * 1.0 / searches;
+}
+
+/**
+ * Print the search hit/miss counters and average probe length
+ */
+void LinkedList::PrintSearchStats() {
+    cout << "hits: " << searchHits
+        << " | misses: " << searchMisses
+        << " | average probe length: " << AverageProbeLength() << endl;
+}
+
+/**
+ * Reset the search counters to zero
+ */
+void LinkedList::ResetSearchStats() {
+    searchHits = 0;
+    searchMisses = 0;
+    searchProbes = 0;
+}
+
+/**
+ * Compare two bids on the selected sort field
+ *
+ * @return true if a belongs before b
+ */
+bool LinkedList::sortsBefore(const Bid& a, const Bid& b, SortKey key) {
+    switch (key) {
+    case SORT_BY_TITLE:
+        return a.title < b.title;
+    case SORT_BY_AMOUNT:
+        return a.amount < b.amount;
+    default:
+        return a.bidId < b.bidId;
+    }
+}
+
+/**
+ * Cut a run of count nodes off the front of a chain
+ *
+ * @param start first node of the run
+ * @param count number of nodes to keep in the run
+ * @return the first node after the run (or nullptr)
+ */
+LinkedList::Node* LinkedList::splitAfter(Node* start, int count) {
+
+    for (int i = 1; start != nullptr && i < count; ++i) {
+        start = start->next;
+    }
+    if (start == nullptr) {
+        return nullptr;
+    }
+
+    Node* rest = start->next;
+    start->next = nullptr;
+    return rest;
+}
+
+/**
+ * Merge two sorted runs by relinking their next pointers.
+ * Ties keep the left node first so the sort is stable.
+ *
+ * @param runTail set to the last node of the merged run
+ * @return the first node of the merged run
+ */
+LinkedList::Node* LinkedList::mergeRuns(Node* left, Node* right, SortKey key, Node** runTail) {
+
+    Node dummy;
+    Node* last = &dummy;
+
+    while (left != nullptr && right != nullptr) {
+        if (sortsBefore(right->bid, left->bid, key)) {
+            last->next = right;
+            right = right->next;
+        }
+        else {
+            last->next = left;
+            left = left->next;
+        }
+        last = last->next;
+    }
+
+    last->next = (left != nullptr) ? left : right;
+    while (last->next != nullptr) {
+        last = last->next;
+    }
+
+    *runTail = last;
+    return dummy.next;
+}
+
+/**
+ * Sort the list in place with a bottom-up merge sort.
+ * Runs of width 1, 2, 4, ... are merged pass by pass, so no recursion
+ * is needed and only node pointers move; bids are never copied.
+ *
+ * @param key the bid field to order by
+ */
+void LinkedList::Sort(SortKey key) {
+
+    if (size < 2) {
         return;
+    }
 
-    // special case if the bidId matches the head
-    if (bidId == head->bid.bidId) {
+    for (int width = 1; width < size; width *= 2) {
+        Node* remaining = head;
+        Node* sortedHead = nullptr;
+        Node* sortedTail = nullptr;
 
-        // save the head temporarily
-        Node* temp = head;
+        // merge each pair of neighboring runs and append it to the result
+        while (remaining != nullptr) {
+            Node* left = remaining;
+            Node* right = splitAfter(left, width);
+            remaining = splitAfter(right, width);
 
-        // move the pointer to the next node, which will be the new head
-        head = head->next;
+            Node* runTail;
+            Node* run = mergeRuns(left, right, key, &runTail);
+
+            if (sortedTail == nullptr) {
+                sortedHead = run;
+            }
+            else {
+                sortedTail->next = run;
+            }
+            sortedTail = runTail;
+        }
+
+        head = sortedHead;
+        tail = sortedTail;
+    }
+
+    // the merge passes only maintain next links, so rebuild prev links
+    Node* prev = nullptr;
+    for (Node* current = head; current != nullptr; current = current->next) {
+        current->prev = prev;
+        prev = current;
+    }
+
+    // copies of an id may have changed order, so point the index at
+    // whichever copy now comes first
+    if (useIndex && duplicateIds > 0) {
+        index.clear();
+        for (Node* current = head; current != nullptr; current = current->next) {
+            index.emplace(current->bid.bidId, current);
+        }
+    }
+}
+
+/**
+ * Returns a cursor at the first bid in the list
+ */
+LinkedList::Cursor LinkedList::Begin() {
+    Cursor cursor;
+    cursor.node = head;
+    cursor.position = 0;
+    return cursor;
+}
+
+/**
+ * Returns a cursor at the given position (0 is the head).
+ * Walks from whichever end of the list is closer.
+ *
+ * @param position index of the bid to start at
+ */
+LinkedList::Cursor LinkedList::Seek(int position) {
+
+    Cursor cursor;
+    cursor.position = position;
+
+    if (position < 0 || position >= size) {
+        cursor.position = size;
+        return cursor;
+    }
+
+    if (position <= size / 2) {
+        cursor.node = head;
+        for (int i = 0; i < position; ++i) {
+            cursor.node = cursor.node->next;
+        }
+    }
+    else {
+        cursor.node = tail;
+        for (int i = size - 1; i > position; --i) {
+            cursor.node = cursor.node->prev;
+        }
+    }
+
+    return cursor;
+}
+
+/**
+ * Copy up to count bids starting at the cursor and move the cursor
+ * past them, so the next call resumes where this one stopped
+ *
+ * @param cursor the cursor to read from and advance
+ * @param count maximum number of bids to return
+ * @param rows the bids are appended here
+ * @return number of bids appended
+ */
+int LinkedList::Fetch(Cursor& cursor, int count, vector<Bid>& rows) {
+
+    int fetched = 0;
+    while (cursor.node != nullptr && fetched < count) {
+        rows.push_back(cursor.node->bid);
+        cursor.node = cursor.node->next;
+        ++cursor.position;
+        ++fetched;
+    }
+
+    return fetched;
+}
+
+/**
+ * Make room in the bidId index for count more bids, so a bulk load
+ * does not rehash it as it grows. Each entry is still its own node.
+ *
+ * @param count number of bids about to be added
+ */
+void LinkedList::Reserve(int count) {
+    if (useIndex) {
+        index.reserve(size + count);
+    }
+}
+
+/**
+ * Returns the current size (number of elements) in the list
+ */
+int LinkedList::Size() {
+    return size;
+}
+
+//============================================================================
+// Unrolled Linked-List class definition
+//============================================================================
+
+// size of a cache line on the targets this program is built for
+const int CACHE_LINE_SIZE = 64;
+
+// number of bids stored in each block of the unrolled list; the id
+// hashes of a full block fill exactly one cache line
+const int BLOCK_CAPACITY = CACHE_LINE_SIZE / sizeof(size_t);
+
+// a block that falls below this many bids is merged with a neighbour
+const int BLOCK_MIN_COUNT = BLOCK_CAPACITY / 2;
+
+/**
+ * Define a class containing data members and methods to
+ * implement an unrolled linked-list. Each block keeps the hashes
+ * of its bid ids in one contiguous cache line next to the array of
+ * bids, so a search compares keys without striding over titles and
+ * funds, and only follows a pointer once per block instead of once
+ * per bid. Removing bids merges thin blocks so the list stays dense.
+ */
+class UnrolledLinkedList {
+
+private:
+    // Internal structure for a block of list entries; the id hashes
+    // fill the block's first cache line and the header starts the second
+    struct alignas(CACHE_LINE_SIZE) Block {
+        size_t idHashes[BLOCK_CAPACITY];
+        int count;
+        Block* next;
+        Bid bids[BLOCK_CAPACITY];
+
+        // default constructor
+        Block() {
+            count = 0;
+            next = nullptr;
+        }
+    };
+
+    Block* head;
+    Block* tail;
+    int size = 0;
+
+    static size_t hashId(const string& bidId);
+    static void moveEntry(Block* from, int fromSlot, Block* to, int toSlot);
+    void mergeBlock(Block* prev, Block* block);
+
+public:
+    UnrolledLinkedList();
+    virtual ~UnrolledLinkedList();
+    void Append(Bid bid);
+    void Prepend(Bid bid);
+    void PrintList();
+    void Remove(string bidId);
+    Bid Search(string bidId);
+    int Size();
+    bool Empty();
+};
+
+/**
+ * Default constructor
+ */
+UnrolledLinkedList::UnrolledLinkedList() {
+
+    // set head and tail pointers to null
+    head = nullptr;
+    tail = nullptr;
+}
+
+/**
+ * Destructor
+ */
+UnrolledLinkedList::~UnrolledLinkedList() {
+
+    // walk the blocks, deleting each one
+    Block* current = head;
+    while (current != nullptr) {
+        Block* temp = current;
+        current = current->next;
+        delete temp;
+    }
+}
+
+// function to return bool based on whether list size is 0 or not
+bool UnrolledLinkedList::Empty() {
+    return this->Size() <= 0;
+}
+
+// function to return the key stored for a bid id in a block
+size_t UnrolledLinkedList::hashId(const string& bidId) {
+    return std::hash<string>()(bidId);
+}
+
+// function to move one bid and its id hash between block slots
+void UnrolledLinkedList::moveEntry(Block* from, int fromSlot, Block* to, int toSlot) {
+    to->idHashes[toSlot] = from->idHashes[fromSlot];
+    to->bids[toSlot] = std::move(from->bids[fromSlot]);
+}
+
+/**
+ * Merge a block that fell below half full with a neighbour
+ *
+ * @param prev the block before the thin one, or null at the head
+ * @param block the block that fell below half full
+ */
+void UnrolledLinkedList::mergeBlock(Block* prev, Block* block) {
+
+    Block* next = block->next;
+
+    // if there is a block after this one, then pull bids forward from it
+    if (next != nullptr) {
+
+        // if both fit in one block, then absorb the next block whole
+        if (block->count + next->count <= BLOCK_CAPACITY) {
+            for (int i = 0; i < next->count; ++i) {
+                moveEntry(next, i, block, block->count + i);
+            }
+            block->count += next->count;
+            block->next = next->next;
+            if (tail == next) {
+                tail = block;
+            }
+            delete next;
+            return;
+        }
+
+        // otherwise borrow just enough to make this block half full
+        int borrow = BLOCK_MIN_COUNT - block->count;
+        for (int i = 0; i < borrow; ++i) {
+            moveEntry(next, i, block, block->count + i);
+        }
+        for (int i = borrow; i < next->count; ++i) {
+            moveEntry(next, i, next, i - borrow);
+        }
+        for (int i = next->count - borrow; i < next->count; ++i) {
+            next->bids[i] = Bid();
+        }
+        block->count += borrow;
+        next->count -= borrow;
+        return;
+    }
+
+    // a thin tail block folds into the block before it when it fits
+    if (prev != nullptr && prev->count + block->count <= BLOCK_CAPACITY) {
+        for (int i = 0; i < block->count; ++i) {
+            moveEntry(block, i, prev, prev->count + i);
+        }
+        prev->count += block->count;
+        prev->next = nullptr;
+        tail = prev;
+        delete block;
+    }
+}
+
+/**
+ * Append a new bid to the end of the list
+ */
+void UnrolledLinkedList::Append(Bid bid) {
+
+    // if there is no tail block or it is full, then add a new block
+    if (tail == nullptr || tail->count == BLOCK_CAPACITY) {
+        Block* newBlock = new Block();
+
+        if (tail == nullptr) {
+            head = newBlock;
+        }
+        else {
+            tail->next = newBlock;
+        }
+        tail = newBlock;
+    }
+
+    // store the bid and its key in the next open slot of the tail block
+    tail->idHashes[tail->count] = hashId(bid.bidId);
+    tail->bids[tail->count] = std::move(bid);
+    tail->count += 1;
+
+    // increment the size of the list
+    this->size += 1;
+}
+
+/**
+ * Prepend a new bid to the start of the list
+ */
+void UnrolledLinkedList::Prepend(Bid bid) {
+
+    // if the list is empty, then append already handles the new block
+    if (this->Empty()) {
+        Append(bid);
+        return;
+    }
+
+    // if the head block is full, then put a new block in front of it
+    if (head->count == BLOCK_CAPACITY) {
+        Block* newBlock = new Block();
+        newBlock->next = head;
+        head = newBlock;
+    }
+
+    // shift the bids in the head block right by one to open slot 0
+    for (int i = head->count; i > 0; --i) {
+        moveEntry(head, i - 1, head, i);
+    }
+    head->idHashes[0] = hashId(bid.bidId);
+    head->bids[0] = std::move(bid);
+    head->count += 1;
+
+    // increment size of the list
+    this->size += 1;
+}
+
+/**
+ * Simple output of all bids in the list
+ */
+void UnrolledLinkedList::PrintList() {
+
+    // create count variable for counting
+    int count{};
+
+    cout << "\nList of bids:\n";
+
+    // walk each block and print each bid in it
+    for (Block* block = head; block != nullptr; block = block->next) {
+        for (int i = 0; i < block->count; ++i) {
+            cout << block->bids[i].bidId << ": "
+                << block->bids[i].title << " | "
+                << block->bids[i].amount << " | "
+                << block->bids[i].fund << endl;
+            ++count;
+        }
+    }
+
+    cout << "\n[[ " << count << " records displayed ]]\n";
+}
+
+/**
+ * Remove a specified bid
+ *
+ * @param bidId The bid id to remove from the list
+ */
+void UnrolledLinkedList::Remove(string bidId) {
+
+    size_t key = hashId(bidId);
+
+    // walk the blocks keeping track of the previous block
+    // so an emptied or thin block can be unlinked or merged
+    Block* prev = nullptr;
+    for (Block* block = head; block != nullptr; prev = block, block = block->next) {
+        for (int i = 0; i < block->count; ++i) {
+            if (block->idHashes[i] != key || bidId != block->bids[i].bidId) {
+                continue;
+            }
+
+            cout << "\n\n[[ Deleted node: " << bidId << " ]]\n";
+
+            // close the gap by shifting the remaining bids left
+            for (int j = i; j < block->count - 1; ++j) {
+                moveEntry(block, j + 1, block, j);
+            }
+            block->count -= 1;
+            block->bids[block->count] = Bid();
+
+            // if the block is now empty, then unlink and delete it
+            if (block->count == 0) {
+                if (prev == nullptr) {
+                    head = block->next;
+                }
+                else {
+                    prev->next = block->next;
+                }
+                if (tail == block) {
+                    tail = prev;
+                }
+                delete block;
+            }
+            // if it is less than half full, then merge it with a neighbour
+            else if (block->count < BLOCK_MIN_COUNT) {
+                mergeBlock(prev, block);
+            }
+
+            // decrement size to account for deletion
+            this->size -= 1;
+            return;
+        }
+    }
+
+    cout << "\nBid id " << bidId << " not found\n\n";
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ */
+Bid UnrolledLinkedList::Search(string bidId) {
+
+    size_t key = hashId(bidId);
+
+    // scan the id hashes of each block and only read a bid on a match
+    for (Block* block = head; block != nullptr; block = block->next) {
+        for (int i = 0; i < block->count; ++i) {
+            if (block->idHashes[i] == key && bidId == block->bids[i].bidId) {
+                return block->bids[i];
+            }
+        }
+    }
+
+    // Return an empty bid if the key is not found
+    return {};
+}
+
+/**
+ * Returns the current size (number of elements) in the list
+ */
+int UnrolledLinkedList::Size() {
+    return size;
+}
+
+//============================================================================
+// Skip List class definition
+//============================================================================
+
+// highest level a skip list node can reach; 4^16 bids is plenty
+const int SKIP_MAX_LEVEL = 16;
+
+/**
+ * Define a class containing data members and methods to implement
+ * a skip list ordered by bidId. Each node is promoted to the next
+ * level with probability 1/4, so Search and Remove take O(log n)
+ * expected steps and PrintList and range scans walk bids in order.
+ * Like the linked list, it keeps every bid it is given: bids with the
+ * same id sit side by side in the order they were added.
+ */
+class SkipList {
+
+private:
+    // Internal structure for list entries
+    struct Node {
+        Bid bid;
+        vector<Node*> forward;
+
+        // initialize with a bid and the number of levels it spans
+        Node(Bid aBid, int level) : bid(aBid), forward(level, nullptr) {}
+    };
+
+    // head sentinel spanning every level
+    Node* head;
+    int level = 1;
+    int size = 0;
+    mt19937 rng;
+
+    int randomLevel();
+
+    // helper function to fill in the last node before bidId on every level
+    Node* findPredecessors(string bidId, Node* update[], bool pastEqual = false);
+
+public:
+    SkipList();
+    virtual ~SkipList();
+    void Append(Bid bid);
+    void PrintList();
+    void PrintRange(string lowId, string highId);
+    vector<Bid> Range(string lowId, string highId);
+    bool Remove(string bidId);
+    Bid Search(string bidId);
+    int Size();
+    bool Empty();
+};
+
+/**
+ * Default constructor
+ */
+SkipList::SkipList() : rng(5489u) {
+
+    // the head sentinel holds no bid and links every level
+    head = new Node(Bid(), SKIP_MAX_LEVEL);
+}
+
+/**
+ * Destructor
+ */
+SkipList::~SkipList() {
+
+    // the bottom level links every node, so walk it deleting each one
+    Node* current = head;
+    while (current != nullptr) {
+        Node* temp = current;
+        current = current->forward[0];
+        delete temp;
+    }
+}
+
+/**
+ * Pick a level for a new node: level k is reached with probability 4^-(k-1)
+ */
+int SkipList::randomLevel() {
+    int newLevel = 1;
+    while (newLevel < SKIP_MAX_LEVEL && (rng() & 3) == 0) {
+        ++newLevel;
+    }
+    return newLevel;
+}
+
+/**
+ * Walk down from the top level to the node just before bidId
+ *
+ * @param bidId The bid id to search for
+ * @param update filled with the last node before bidId on each level
+ * @param pastEqual true to stop after the bids with this id instead of before them
+ * @return the first node on the bottom level with bidId >= key (> key when pastEqual)
+ */
+SkipList::Node* SkipList::findPredecessors(string bidId, Node* update[], bool pastEqual) {
+
+    Node* current = head;
+    for (int i = level - 1; i >= 0; --i) {
+        while (current->forward[i] != nullptr &&
+            (current->forward[i]->bid.bidId < bidId || (pastEqual && current->forward[i]->bid.bidId == bidId))) {
+            current = current->forward[i];
+        }
+        update[i] = current;
+    }
+
+    return current->forward[0];
+}
+
+/**
+ * Insert a bid at its ordered position
+ * (after any bids that already have its id)
+ */
+void SkipList::Append(Bid bid) {
+
+    Node* update[SKIP_MAX_LEVEL];
+    findPredecessors(bid.bidId, update, true);
+
+    // levels above the current top start from the head sentinel
+    int newLevel = randomLevel();
+    if (newLevel > level) {
+        for (int i = level; i < newLevel; ++i) {
+            update[i] = head;
+        }
+        level = newLevel;
+    }
+
+    // splice the new node in after its predecessor on each level
+    Node* newNode = new Node(bid, newLevel);
+    for (int i = 0; i < newLevel; ++i) {
+        newNode->forward[i] = update[i]->forward[i];
+        update[i]->forward[i] = newNode;
+    }
+
+    // increment the size of the list
+    this->size += 1;
+}
+
+/**
+ * Simple output of all bids in bidId order
+ */
+void SkipList::PrintList() {
+
+    int count{};
+
+    cout << "\nList of bids:\n";
+
+    for (Node* current = head->forward[0]; current != nullptr; current = current->forward[0]) {
+        cout << current->bid.bidId << ": "
+            << current->bid.title << " | "
+            << current->bid.amount << " | "
+            << current->bid.fund << endl;
+        ++count;
+    }
+
+    cout << "\n[[ " << count << " records displayed ]]\n";
+}
+
+/**
+ * Collect the bids whose ids fall in [lowId, highId]
+ *
+ * @param lowId first bid id in the range
+ * @param highId last bid id in the range
+ * @return the bids in bidId order
+ */
+vector<Bid> SkipList::Range(string lowId, string highId) {
+
+    vector<Bid> bids;
+    Node* update[SKIP_MAX_LEVEL];
+
+    // jump to the first bid in range, then walk the bottom level
+    for (Node* current = findPredecessors(lowId, update);
+        current != nullptr && !(highId < current->bid.bidId);
+        current = current->forward[0]) {
+        bids.push_back(current->bid);
+    }
+
+    return bids;
+}
+
+/**
+ * Print the bids whose ids fall in [lowId, highId]
+ */
+void SkipList::PrintRange(string lowId, string highId) {
+
+    vector<Bid> bids = Range(lowId, highId);
+
+    cout << "\nBids from " << lowId << " to " << highId << ":\n";
+    for (const Bid& bid : bids) {
+        cout << bid.bidId << ": "
+            << bid.title << " | "
+            << bid.amount << " | "
+            << bid.fund << endl;
+    }
+
+    cout << "\n[[ " << bids.size() << " records displayed ]]\n";
+}
+
+/**
+ * Remove a specified bid
+ *
+ * @param bidId The bid id to remove from the list
+ * @return true if a bid was removed; the first of several with the id goes
+ */
+bool SkipList::Remove(string bidId) {
+
+    Node* update[SKIP_MAX_LEVEL];
+    Node* found = findPredecessors(bidId, update);
+
+    if (found == nullptr || found->bid.bidId != bidId) {
+        return false;
+    }
+
+    // unlink the node on every level it spans
+    for (int i = 0; i < (int)found->forward.size(); ++i) {
+        update[i]->forward[i] = found->forward[i];
+    }
+
+    // lower the top level if it is now empty
+    while (level > 1 && head->forward[level - 1] == nullptr) {
+        --level;
+    }
+
+    delete found;
+
+    // decrement size to account for deletion
+    this->size -= 1;
+    return true;
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ */
+Bid SkipList::Search(string bidId) {
+
+    Node* update[SKIP_MAX_LEVEL];
+    Node* found = findPredecessors(bidId, update);
+
+    if (found != nullptr && found->bid.bidId == bidId) {
+        return found->bid;
+    }
+
+    // Return an empty bid if the key is not found
+    return {};
+}
+
+/**
+ * Returns the current size (number of elements) in the list
+ */
+int SkipList::Size() {
+    return size;
+}
+
+// function to return bool based on whether list size is 0 or not
+bool SkipList::Empty() {
+    return this->Size() <= 0;
+}
+
+//============================================================================
+// Lock-free Linked-List class definition
+//============================================================================
+
+/**
+ * Define a class containing data members and methods to implement
+ * a lock-free linked-list (Harris/Michael) that supports concurrent
+ * Append, Search and Remove from any number of threads.
+ *
+ * Removal first marks the low bit of the node's next pointer (logical
+ * delete) and then swings the predecessor past it (physical delete).
+ * The algorithm needs a fixed position for every key, so bids are kept
+ * in bidId order rather than insertion order, and duplicate ids are
+ * rejected.
+ */
+class ConcurrentLinkedList {
+
+private:
+    // Internal structure for list entries
+    struct Node {
+        Bid bid;
+        atomic<Node*> next;
+
+        // initialize with a bid
+        Node(Bid aBid) : bid(aBid), next(nullptr) {}
+    };
+
+    atomic<Node*> head{nullptr};
+    atomic<int> size{0};
+    EpochReclaimer reclaimer;
+
+    // helpers for the deletion mark stored in the low pointer bit
+    static bool isMarked(Node* p) {
+        return (reinterpret_cast<uintptr_t>(p) & 1) != 0;
+    }
+    static Node* marked(Node* p) {
+        return reinterpret_cast<Node*>(reinterpret_cast<uintptr_t>(p) | 1);
+    }
+    static Node* unmarked(Node* p) {
+        return reinterpret_cast<Node*>(reinterpret_cast<uintptr_t>(p) & ~uintptr_t(1));
+    }
+    static void deleteNode(void* p) {
+        delete static_cast<Node*>(p);
+    }
+
+    // helper to locate the window around a key, unlinking marked nodes
+    bool find(EpochReclaimer::Guard& guard, const string& bidId,
+        atomic<Node*>*& prevNext, Node*& curr);
+
+public:
+    ConcurrentLinkedList() {}
+    virtual ~ConcurrentLinkedList();
+    bool Append(Bid bid);
+    void PrintList();
+    bool Remove(string bidId);
+    Bid Search(string bidId);
+    int Size();
+    bool Empty();
+};
+
+/**
+ * Destructor
+ */
+ConcurrentLinkedList::~ConcurrentLinkedList() {
+
+    // no other thread can be using the list, so just walk and delete
+    Node* current = unmarked(head.load());
+    while (current != nullptr) {
+        Node* temp = current;
+        current = unmarked(current->next.load());
+        delete temp;
+    }
+}
+
+/**
+ * Find the first node whose bidId is not less than the key.
+ * Any marked node met on the way is unlinked and retired.
+ *
+ * @param guard the caller's epoch guard
+ * @param bidId The bid id to search for
+ * @param prevNext set to the link that points at curr
+ * @param curr set to the first node with bidId >= key (or nullptr)
+ * @return true if curr holds the key
+ */
+bool ConcurrentLinkedList::find(EpochReclaimer::Guard& guard, const string& bidId,
+    atomic<Node*>*& prevNext, Node*& curr) {
+
+retry:
+    prevNext = &head;
+    curr = prevNext->load();
+
+    while (curr != nullptr) {
+        Node* next = curr->next.load();
+
+        // curr is logically deleted, so try to unlink it
+        if (isMarked(next)) {
+            Node* expected = curr;
+            if (!prevNext->compare_exchange_strong(expected, unmarked(next))) {
+                goto retry;
+            }
+            guard.Retire(curr, deleteNode);
+            curr = unmarked(next);
+            continue;
+        }
+
+        if (!(curr->bid.bidId < bidId)) {
+            return curr->bid.bidId == bidId;
+        }
+
+        prevNext = &curr->next;
+        curr = next;
+    }
+
+    return false;
+}
+
+/**
+ * Insert a new bid at its position in the list
+ *
+ * @return false if the bid id is already present
+ */
+bool ConcurrentLinkedList::Append(Bid bid) {
+
+    EpochReclaimer::Guard guard = reclaimer.Pin();
+    Node* newNode = new Node(bid);
+
+    while (true) {
+        atomic<Node*>* prevNext;
+        Node* curr;
+
+        // duplicate bid ids are not allowed
+        if (find(guard, newNode->bid.bidId, prevNext, curr)) {
+            delete newNode;
+            return false;
+        }
+
+        // link the new node in front of curr
+        newNode->next.store(curr, memory_order_relaxed);
+        if (prevNext->compare_exchange_strong(curr, newNode)) {
+            size.fetch_add(1);
+            return true;
+        }
+    }
+}
 
+/**
+ * Simple output of all bids in the list
+ */
+void ConcurrentLinkedList::PrintList() {
 
-        cout << "\n\n[[ Deleted Node: " << temp->bid.bidId << " ]]\n";
+    EpochReclaimer::Guard guard = reclaimer.Pin();
+    int count{};
 
+    cout << "\nList of bids:\n";
 
-        // delete the original head and set it to null
-        delete temp;
-        temp = nullptr;
+    for (Node* curr = unmarked(head.load()); curr != nullptr; curr = unmarked(curr->next.load())) {
+        if (isMarked(curr->next.load())) {
+            continue;
+        }
+        cout << curr->bid.bidId << ": "
+            << curr->bid.title << " | "
+            << curr->bid.amount << " | "
+            << curr->bid.fund << endl;
+        ++count;
+    }
 
-        // decrement size of list to account for deletion
-        this->size -= 1;
+    cout << "\n[[ " << count << " records displayed ]]\n";
+}
 
-        return;
-    }
+/**
+ * Remove a specified bid
+ *
+ * @param bidId The bid id to remove from the list
+ * @return true if this call removed the bid
+ */
+bool ConcurrentLinkedList::Remove(string bidId) {
 
-    // now set up the prev and curr temporary pointers
-    // prev will be the node we keep after deletion of a node
-    // curr will be the node we delete
-    // we will walk the list incrementing both pointers while
-    // searching for the bidId
-    Node* prev = this->head;
-    Node* curr = this->head->next;
+    EpochReclaimer::Guard guard = reclaimer.Pin();
 
-    // special case if the bidId matches the tail
-    if (bidId == tail->bid.bidId) {
+    while (true) {
+        atomic<Node*>* prevNext;
+        Node* curr;
 
-        // traverse the list with both pointers
-        // until we get to the end of the list with curr
-        // prev will end up being the node before the tail,
-        // and curr will be the tail
-        while (curr->next != nullptr) {
-            prev = prev->next;
-            curr = curr->next;
+        if (!find(guard, bidId, prevNext, curr)) {
+            return false;
         }
 
-        // set prev->next to nullptr since this node is the new tail
-        prev->next = nullptr;
+        // logically delete the node by marking its next pointer
+        Node* next = curr->next.load();
+        if (isMarked(next)) {
+            continue;
+        }
+        if (!curr->next.compare_exchange_strong(next, marked(next))) {
+            continue;
+        }
+        size.fetch_sub(1);
 
-        // set tail to prev
-        tail = prev;
+        // physically unlink it, or let a later find do it
+        Node* expected = curr;
+        if (prevNext->compare_exchange_strong(expected, next)) {
+            guard.Retire(curr, deleteNode);
+        }
+        else {
+            find(guard, bidId, prevNext, curr);
+        }
+        return true;
+    }
+}
 
-        cout << "\n\n[[ Deleted node: " << curr->bid.bidId << " ]]\n";
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ */
+Bid ConcurrentLinkedList::Search(string bidId) {
 
-        // now delete original tail and set the pointer to null
-        delete curr;
-        curr = nullptr;
+    EpochReclaimer::Guard guard = reclaimer.Pin();
 
-        // decrement size to account for deletion
-        this->size -= 1;
+    // readers never write; they just skip over marked nodes
+    Node* curr = unmarked(head.load());
+    while (curr != nullptr && curr->bid.bidId < bidId) {
+        curr = unmarked(curr->next.load());
+    }
 
-        return;
+    if (curr != nullptr && curr->bid.bidId == bidId && !isMarked(curr->next.load())) {
+        return curr->bid;
     }
 
-    // if bidID is not the head and not the tail,
-    // then we traverse the list with prev and curr
-    // until we find the node to be deleted
-    while (curr->next != nullptr) {
+    // Return an empty bid if the key is not found
+    return {};
+}
 
-        if (bidId == curr->bid.bidId) {
+/**
+ * Returns the current size (number of elements) in the list
+ */
+int ConcurrentLinkedList::Size() {
+    return size.load();
+}
 
-            // temporary pointer to curr,
-            // because curr will be deleted
-            Node* temp = curr;
+// function to return bool based on whether list size is 0 or not
+bool ConcurrentLinkedList::Empty() {
+    return this->Size() <= 0;
+}
 
-            // set the node after curr to be the
-            // new neighbor of prev
-            prev->next = temp->next;
+/**
+ * Define a class that protects the same ordered list with a single mutex.
+ * Used as the baseline for the concurrent list benchmark.
+ */
+class MutexLinkedList {
 
-            cout << "\n\n[[ Deleting node: " << temp->bid.bidId
-                << " ]]\n\n";
+private:
+    // Internal structure for list entries
+    struct Node {
+        Bid bid;
+        Node* next;
 
-            // delete the node and set temp to null
-            delete temp;
-            temp = nullptr;
+        // initialize with a bid
+        Node(Bid aBid) : bid(aBid), next(nullptr) {}
+    };
 
-            // decrement size of list
-            this->size -= 1;
+    Node* head = nullptr;
+    int size = 0;
+    mutex lock;
 
-            return;
+public:
+    MutexLinkedList() {}
+    virtual ~MutexLinkedList();
+    bool Append(Bid bid);
+    bool Remove(string bidId);
+    Bid Search(string bidId);
+    int Size();
+};
 
-        }
-        else {
+/**
+ * Destructor
+ */
+MutexLinkedList::~MutexLinkedList() {
+    while (head != nullptr) {
+        Node* temp = head;
+        head = head->next;
+        delete temp;
+    }
+}
 
-            // walk the list with both pointers
-            // continue the loop until we get to 
-            // the end of the list or we find the node
-            prev = prev->next;
-            curr = curr->next;
-        }
+/**
+ * Insert a new bid at its position in the list
+ *
+ * @return false if the bid id is already present
+ */
+bool MutexLinkedList::Append(Bid bid) {
+    lock_guard<mutex> guard(lock);
 
+    Node** link = &head;
+    while (*link != nullptr && (*link)->bid.bidId < bid.bidId) {
+        link = &(*link)->next;
+    }
+    if (*link != nullptr && (*link)->bid.bidId == bid.bidId) {
+        return false;
     }
 
+    Node* newNode = new Node(bid);
+    newNode->next = *link;
+    *link = newNode;
+    size += 1;
+    return true;
 }
 
 /**
- * Search for the specified bidId
+ * Remove a specified bid
  *
- * @param bidId The bid id to search for
+ * @return true if the bid was removed
  */
-Bid LinkedList::Search(string bidId) {
+bool MutexLinkedList::Remove(string bidId) {
+    lock_guard<mutex> guard(lock);
 
-    // Return empty bid if the list is empty
-    if (head == nullptr) {
-        return {};
+    Node** link = &head;
+    while (*link != nullptr && (*link)->bid.bidId < bidId) {
+        link = &(*link)->next;
+    }
+    if (*link == nullptr || (*link)->bid.bidId != bidId) {
+        return false;
     }
 
-    // Set currNode to the list head
-    Node* currNode = this->head;
+    Node* temp = *link;
+    *link = temp->next;
+    delete temp;
+    size -= 1;
+    return true;
+}
 
-    // Loop through the list. If we find the bidId,
-    // then return the node.
-    while (currNode != nullptr) {
-        if (bidId == currNode->bid.bidId) {
-            return currNode->bid;
-        }
+/**
+ * Search for the specified bidId
+ */
+Bid MutexLinkedList::Search(string bidId) {
+    lock_guard<mutex> guard(lock);
 
-        currNode = currNode->next;
+    Node* curr = head;
+    while (curr != nullptr && curr->bid.bidId < bidId) {
+        curr = curr->next;
+    }
+    if (curr != nullptr && curr->bid.bidId == bidId) {
+        return curr->bid;
     }
-
-    // Return an empty bid if the key is not found
     return {};
 }
 
 /**
  * Returns the current size (number of elements) in the list
  */
-int LinkedList::Size() {
+int MutexLinkedList::Size() {
+    lock_guard<mutex> guard(lock);
     return size;
 }
 
@@ -364,7 +1815,7 @@ int LinkedList::Size() {
  *
  * @param bid struct containing the bid info
  */
-void displayBid(Bid bid) {
+void displayBid(const Bid& bid) {
     cout << "[[ " << bid.bidId << ": " 
         << bid.title << " | " 
         << bid.amount << " | " 
@@ -402,12 +1853,26 @@ Bid getBid() {
 }
 
 
+// size a list for the rows about to be loaded; only the indexed
+// linked list has anything to reserve
+void reserveRows(LinkedList* list, int rowCount) {
+    list->Reserve(rowCount);
+}
+
+template <typename List>
+void reserveRows(List*, int) {
+}
+
 /**
- * Load a CSV file containing bids into a LinkedList
+ * Load a CSV file containing bids into a list
+ * (works with any of the list classes)
  *
- * @return a LinkedList containing all the bids read
+ * @param filter if given, rows with an id already loaded are skipped;
+ *               the filter answers most rows without searching the list
+ * @return a list containing all the bids read
  */
-void loadBids(string csvPath, LinkedList *list) {
+template <typename List>
+void loadBids(string csvPath, List *list, BidBloomFilter* filter = nullptr) {
 
     if (!list->Empty()) {
         cout << "\n\nFile has already been loaded\n\n";
@@ -419,6 +1884,12 @@ void loadBids(string csvPath, LinkedList *list) {
     // initialize the CSV Parser
     csv::Parser file = csv::Parser(csvPath);
 
+    // size the filter and the list for the rows about to be loaded
+    if (filter != nullptr) {
+        filter->Reserve(file.rowCount());
+    }
+    reserveRows(list, file.rowCount());
+
     try {
         // loop to read rows of a CSV file
         for (int i = 0; i < file.rowCount(); i++) {
@@ -440,6 +1911,14 @@ void loadBids(string csvPath, LinkedList *list) {
             //    list->Append(bid);
 
 
+            // skip duplicate ids; only a possible hit needs a real search
+            if (filter != nullptr) {
+                if (filter->MightContain(bid.bidId) && !list->Search(bid.bidId).bidId.empty()) {
+                    continue;
+                }
+                filter->Add(bid.bidId);
+            }
+
             // add this bid to the end
             list->Append(bid);
 
@@ -464,12 +1943,193 @@ double strToDouble(string str, char ch) {
 }
 
 
+/**
+ * Compare scan time of the node-per-bid list against the unrolled list.
+ * Each list is loaded from the same CSV file and then searched for a
+ * bid id that does not exist, which forces a full scan every time.
+ *
+ * @param csvPath the path to the CSV file to load
+ */
+void compareListLayouts(string csvPath) {
+
+    LinkedList list;
+    UnrolledLinkedList unrolled;
+
+    loadBids(csvPath, &list);
+    loadBids(csvPath, &unrolled);
+
+    // number of full scans to run against each list
+    const int passes = 100;
+    clock_t ticks;
+
+    ticks = clock();
+    for (int i = 0; i < passes; ++i) {
+        list.Search("not a bid id");
+    }
+    ticks = clock() - ticks;
+    cout << "\nLinkedList: " << passes << " full scans of " << list.Size() << " bids" << endl;
+    cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+
+    ticks = clock();
+    for (int i = 0; i < passes; ++i) {
+        unrolled.Search("not a bid id");
+    }
+    ticks = clock() - ticks;
+    cout << "\nUnrolledLinkedList: " << passes << " full scans of " << unrolled.Size() << " bids" << endl;
+    cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+}
+
+/**
+ * Run a mixed workload (80% search, 10% append, 10% remove) against a
+ * list from several threads for a fixed wall-clock time.
+ *
+ * @param list the list to stress
+ * @param threadCount number of worker threads
+ * @param keyCount size of the bid id key space
+ * @return operations completed per second
+ */
+template <typename List>
+double stressList(List& list, int threadCount, int keyCount) {
+
+    // wall time is used since clock() adds up the cpu time of every thread
+    const auto duration = chrono::milliseconds(250);
+    atomic<bool> stop{false};
+    atomic<long long> totalOps{0};
+    vector<thread> workers;
+
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&, t]() {
+            mt19937 rng(t + 1);
+            long long ops = 0;
+            Bid bid;
+
+            while (!stop.load(memory_order_relaxed)) {
+                bid.bidId = to_string(rng() % keyCount);
+                unsigned op = rng() % 10;
+
+                if (op == 0) {
+                    list.Append(bid);
+                }
+                else if (op == 1) {
+                    list.Remove(bid.bidId);
+                }
+                else {
+                    list.Search(bid.bidId);
+                }
+                ++ops;
+            }
+            totalOps.fetch_add(ops);
+        });
+    }
+
+    this_thread::sleep_for(duration);
+    stop.store(true);
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    return totalOps.load() / chrono::duration<double>(duration).count();
+}
+
+/**
+ * Compare throughput of the lock-free list against the mutex-protected
+ * list at increasing thread counts.
+ */
+void benchmarkConcurrentLists() {
+
+    // bid id key space; half of it is loaded before timing starts
+    const int keyCount = 2000;
+
+    // the workers and this thread each need an epoch slot of their own
+    int maxThreads = min<int>(max(4u, thread::hardware_concurrency()), EPOCH_MAX_THREADS - 1);
+
+    cout << "\nthreads | lock-free ops/sec | mutex ops/sec\n";
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        ConcurrentLinkedList lockFree;
+        MutexLinkedList locked;
+
+        for (int i = 0; i < keyCount; i += 2) {
+            Bid bid;
+            bid.bidId = to_string(i);
+            lockFree.Append(bid);
+            locked.Append(bid);
+        }
+
+        double lockFreeOps = stressList(lockFree, threads, keyCount);
+        double lockedOps = stressList(locked, threads, keyCount);
+
+        cout << threads << " | " << (long long)lockFreeOps
+            << " | " << (long long)lockedOps << endl;
+    }
+}
+
+/**
+ * Compare static, move-to-front and transpose search modes on a lookup
+ * stream that follows a Zipf distribution, so a few bids get most of
+ * the searches the way active auctions do.
+ */
+void benchmarkSelfOrganizingSearch() {
+
+    // number of bids in each list and number of lookups to run
+    const int bidCount = 10000;
+    const int lookups = 50000;
+
+    // build the Zipf (s = 1) cumulative distribution over bid ranks
+    vector<double> cdf(bidCount);
+    double total = 0.0;
+    for (int i = 0; i < bidCount; ++i) {
+        total += 1.0 / (i + 1);
+        cdf[i] = total;
+    }
+
+    // hot bids are spread through the list rather than clustered at the head
+    vector<int> rankToId(bidCount);
+    for (int i = 0; i < bidCount; ++i) {
+        rankToId[i] = i;
+    }
+    mt19937 rng(42);
+    shuffle(rankToId.begin(), rankToId.end(), rng);
+
+    vector<string> keys(lookups);
+    uniform_real_distribution<double> uniform(0.0, total);
+    for (int i = 0; i < lookups; ++i) {
+        int rank = lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin();
+        keys[i] = to_string(rankToId[rank]);
+    }
+
+    const SearchMode modes[] = { SEARCH_STATIC, SEARCH_MOVE_TO_FRONT, SEARCH_TRANSPOSE };
+    const char* names[] = { "static", "move-to-front", "transpose" };
+
+    for (int m = 0; m < 3; ++m) {
+        LinkedList list;
+        for (int i = 0; i < bidCount; ++i) {
+            Bid bid;
+            bid.bidId = to_string(i);
+            list.Append(bid);
+        }
+        list.SetSearchMode(modes[m]);
+
+        clock_t ticks = clock();
+        for (const string& key : keys) {
+            list.Search(key);
+        }
+        ticks = clock() - ticks;
+
+        cout << "\n" << names[m] << ": ";
+        list.PrintSearchStats();
+        cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+    }
+}
+
 // function to determine if a bid search is valide or not
-bool isBidValid(LinkedList& list, Bid& bid) {
-    
-    Bid temp = list.Search(bid.bidId);
+// the filter rules out most new ids before the list is searched
+bool isBidValid(LinkedList& list, BidBloomFilter& filter, Bid& bid) {
 
-    if (!temp.bidId.empty())
+    if (!filter.MightContain(bid.bidId))
+        return true;
+
+    if (list.Find(bid.bidId) != nullptr)
         return false;
 
     return true;
@@ -507,7 +2167,24 @@ int main(int argc, char* argv[]) {
 
     clock_t ticks;
 
-    LinkedList bidList;
+    // keep a bidId index so searches and removals don't scan the list
+    LinkedList bidList(true);
+
+    // ordered bidId index used for range queries; every menu action that
+    // changes bidList makes the same change here
+    SkipList bidIndex;
+
+    // filter over loaded ids for fast duplicate checks
+    BidBloomFilter bidFilter;
+
+    // paging position kept between menu actions, so the next page carries
+    // on from the cursor instead of walking from the head. Any change to
+    // the list may leave the cursor on a moved or removed bid, so changes
+    // mark it stale and the next page seeks to its position again.
+    const int pageSize = 20;
+    LinkedList::Cursor pageCursor;
+    int pageNumber = 0;
+    bool pageCursorValid = false;
 
     Bid bid;
 
@@ -520,6 +2197,13 @@ int main(int argc, char* argv[]) {
         cout << "  4. Display All Bids" << endl;
         cout << "  5. Find Bid" << endl;
         cout << "  6. Remove Bid" << endl;
+        cout << "  7. Compare List Layouts" << endl;
+        cout << "  8. Concurrent List Benchmark" << endl;
+        cout << "  10. Self-Organizing Search Benchmark" << endl;
+        cout << "  11. Display Bid Id Range" << endl;
+        cout << "  12. Sort Bids" << endl;
+        cout << "  13. Display a Page of Bids" << endl;
+        cout << "  14. Display the Next Page of Bids" << endl;
         cout << "  9. Exit" << endl;
         cout << "Enter choice: ";
         cin >> choice;
@@ -535,13 +2219,16 @@ int main(int argc, char* argv[]) {
             // call to create a new bid
             bid = getBid();
 
-            if (isBidValid(bidList, bid)) {
+            if (isBidValid(bidList, bidFilter, bid)) {
 
                 // set up timer
                 ticks = clock();
 
                 // call append function
                 bidList.Append(bid);
+                bidIndex.Append(bid);
+                bidFilter.Add(bid.bidId);
+                pageCursorValid = false;
 
                 // determine number of ticks
                 ticks = clock() - ticks; // current clock ticks minus starting clock ticks
@@ -566,13 +2253,16 @@ int main(int argc, char* argv[]) {
             // call to create the new bid
             bid = getBid();
 
-            if (isBidValid(bidList, bid)) {
+            if (isBidValid(bidList, bidFilter, bid)) {
 
                 // set up timer
                 ticks = clock();
 
                 // call prepend function
                 bidList.Prepend(bid);
+                bidIndex.Append(bid);
+                bidFilter.Add(bid.bidId);
+                pageCursorValid = false;
 
 
                 // determine number of ticks
@@ -598,7 +2288,19 @@ int main(int argc, char* argv[]) {
             ticks = clock();
 
             // call to load bids from file
-            loadBids(csvPath, &bidList);
+            {
+                int indexed = bidList.Size();
+                loadBids(csvPath, &bidList, &bidFilter);
+                pageCursorValid = false;
+
+                // loaded bids go on the end of the list; index just those
+                vector<Bid> rows;
+                LinkedList::Cursor cursor = bidList.Seek(indexed);
+                bidList.Fetch(cursor, bidList.Size() - indexed, rows);
+                for (const Bid& row : rows) {
+                    bidIndex.Append(row);
+                }
+            }
 
             cout << bidList.Size() << " bids read" << endl;
 
@@ -639,17 +2341,19 @@ int main(int argc, char* argv[]) {
             ticks = clock();
 
             // test to see if the bid exists
-            bid = bidList.Search(input);
+            {
+                const Bid* found = bidList.Find(input);
 
-            ticks = clock() - ticks; // current clock ticks minus starting clock ticks
+                ticks = clock() - ticks; // current clock ticks minus starting clock ticks
 
-            // if bid exists, then display it
-            // else inform customer bid does not exist
-            if (!bid.bidId.empty()) {
-                cout << "\nBid found:\n";
-                displayBid(bid);
-            } else {
-            	cout << "\nBid Id " << input << " not found." << endl;
+                // if bid exists, then display it
+                // else inform customer bid does not exist
+                if (found != nullptr) {
+                    cout << "\nBid found:\n";
+                    displayBid(*found);
+                } else {
+                    cout << "\nBid Id " << input << " not found." << endl;
+                }
             }
 
             // determine number of ticks
@@ -681,8 +2385,11 @@ int main(int argc, char* argv[]) {
                 // set up timer
                 ticks = clock();
 
-                // call to remove function
+                // call to remove function; the index removes quietly so
+                // the deletion is only reported once
                 bidList.Remove(input);
+                bidIndex.Remove(input);
+                pageCursorValid = false;
 
                 // determine number of ticks
                 ticks = clock() - ticks; // current clock ticks minus starting clock ticks
@@ -698,6 +2405,147 @@ int main(int argc, char* argv[]) {
 
             break;
 
+        // time full scans of the linked list against the unrolled list
+        case 7:
+
+            compareListLayouts(csvPath);
+
+            break;
+
+        // stress the lock-free list against a mutex-protected list
+        case 8:
+
+            benchmarkConcurrentLists();
+
+            break;
+
+        // compare search modes on a skewed lookup stream
+        case 10:
+
+            benchmarkSelfOrganizingSearch();
+
+            break;
+
+        // print a range of bids in bidId order from the skip list index
+        case 11:
+
+            cout << "\nEnter the first bid id: ";
+            cin.ignore();
+            getline(cin, input);
+
+            {
+                string highId;
+                cout << "Enter the last bid id: ";
+                getline(cin, highId);
+
+                // set up timer
+                ticks = clock();
+
+                bidIndex.PrintRange(input, highId);
+
+                ticks = clock() - ticks; // current clock ticks minus starting clock ticks
+                cout << "time: " << ticks << " clock ticks" << endl;
+                cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+            }
+
+            input = {};
+
+            break;
+
+        // sort the list in place by a bid field
+        case 12:
+
+            cout << "\nSort by 1. title, 2. bid id, 3. amount: ";
+            cin >> input;
+
+            // set up timer
+            ticks = clock();
+
+            if (input == "1") {
+                bidList.Sort(SORT_BY_TITLE);
+            }
+            else if (input == "3") {
+                bidList.Sort(SORT_BY_AMOUNT);
+            }
+            else {
+                bidList.Sort(SORT_BY_BIDID);
+            }
+            pageCursorValid = false;
+
+            ticks = clock() - ticks; // current clock ticks minus starting clock ticks
+            cout << bidList.Size() << " bids sorted" << endl;
+            cout << "time: " << ticks << " clock ticks" << endl;
+            cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+
+            input = {};
+
+            break;
+
+        // display one page of bids using a list cursor
+        case 13:
+
+            cout << "\nEnter the page number: ";
+            cin >> input;
+
+            {
+                int page = max(1, atoi(input.c_str()));
+                vector<Bid> rows;
+
+                // set up timer
+                ticks = clock();
+
+                pageCursor = bidList.Seek((page - 1) * pageSize);
+                bidList.Fetch(pageCursor, pageSize, rows);
+                pageNumber = page;
+                pageCursorValid = true;
+
+                ticks = clock() - ticks; // current clock ticks minus starting clock ticks
+
+                cout << "\nPage " << page << ":\n";
+                for (const Bid& row : rows) {
+                    displayBid(row);
+                }
+                cout << "time: " << ticks << " clock ticks" << endl;
+                cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+            }
+
+            input = {};
+
+            break;
+
+        // display the page after the last one shown, resuming from the saved cursor
+        case 14:
+
+            {
+                vector<Bid> rows;
+
+                // set up timer
+                ticks = clock();
+
+                if (!pageCursorValid) {
+                    pageCursor = bidList.Seek(pageNumber * pageSize);
+                    pageCursorValid = true;
+                }
+                bidList.Fetch(pageCursor, pageSize, rows);
+
+                ticks = clock() - ticks; // current clock ticks minus starting clock ticks
+
+                if (rows.empty()) {
+                    cout << "\nNo more bids." << endl;
+                    break;
+                }
+                pageNumber += 1;
+
+                cout << "\nPage " << pageNumber << ":\n";
+                for (const Bid& row : rows) {
+                    displayBid(row);
+                }
+                cout << "time: " << ticks << " clock ticks" << endl;
+                cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+            }
+
+            break;
+
         default:
             break;
         }
@@ -7,12 +7,59 @@
 //============================================================================
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <climits>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
 #include <string> // atoi
+#include <string_view>
+#include <thread>
 #include <time.h>
-
+#include <unordered_map>
+#include <vector>
+
+// SSE2 is used for group probing when the compiler targets it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HASHTABLE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// CRC32C instructions are used for string hashing when available
+#if (defined(__SSE4_2__) || defined(__AVX__)) && (defined(__x86_64__) || defined(_M_X64))
+#define HASHTABLE_CRC32C 1
+#include <nmmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// memory-mapped files for the on-disk index
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "BidBloomFilter.hpp"
 #include "CSVparser.hpp"
+#include "EpochReclamation.hpp"
 
 using namespace std;
 
@@ -23,9 +70,93 @@ using namespace std;
 const unsigned int DEFAULT_SIZE = 179;
 //const unsigned int DEFAULT_SIZE = 10000;
 
+// the table grows once bids per bucket would pass this ratio
+const float MAX_LOAD_FACTOR = 0.75f;
+
+// old buckets migrated by each operation during an incremental rehash
+const unsigned int REHASH_STEP_BUCKETS = 8;
+
+// keys resolved together by SearchBatch; enough to keep many cache
+// misses in flight without evicting the lines prefetched first
+const unsigned int SEARCH_BATCH_SIZE = 16;
+
+// BulkInsert only adds another thread for each this many rows
+const size_t BULK_ROWS_PER_THREAD = 16384;
+
 // forward declarations
 double strToDouble(string str, char ch);
 
+/**
+ * Ask the CPU to start loading the cache line holding an address.
+ * This is only a hint and never faults, even on a bad address.
+ */
+inline void prefetchLine(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#elif defined(HASHTABLE_SSE2)
+    _mm_prefetch((const char*)address, _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
+
+/**
+ * Multiply two 64-bit values and fold the 128-bit product together.
+ * Every output bit depends on every input bit.
+ */
+inline uint64_t foldMultiply(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = (__uint128_t)a * b;
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t high;
+    uint64_t low = _umul128(a, b, &high);
+    return low ^ high;
+#else
+    uint64_t product = a * b;
+    return product ^ (product >> 32) ^ ((a ^ (a >> 29)) * (b | 1));
+#endif
+}
+
+/**
+ * Fast 64-bit hash of a bid id in the style of wyhash. The id is read
+ * 8 bytes at a time, so it costs a few multiplies for a typical id.
+ * When the compiler targets SSE4.2 the bytes go through the CRC32C
+ * instruction instead and the result is finished with one multiply.
+ * Any string hashes safely, numeric or not.
+ *
+ * @param bidId the id to hash
+ * @return the hash value
+ */
+inline uint64_t hashBidId(string_view bidId) {
+    const char* bytes = bidId.data();
+    size_t length = bidId.size();
+    uint64_t chunk;
+
+#ifdef HASHTABLE_CRC32C
+    uint64_t crc = 0;
+    for (; length >= 8; bytes += 8, length -= 8) {
+        memcpy(&chunk, bytes, 8);
+        crc = _mm_crc32_u64(crc, chunk);
+    }
+    for (; length > 0; ++bytes, --length) {
+        crc = _mm_crc32_u8((unsigned int)crc, (unsigned char)*bytes);
+    }
+    return foldMultiply(crc ^ ((uint64_t)bidId.size() << 32), 0x9e3779b97f4a7c15ULL);
+#else
+    uint64_t seed = 0xa0761d6478bd642fULL ^ length;
+    for (; length > 8; bytes += 8, length -= 8) {
+        memcpy(&chunk, bytes, 8);
+        seed = foldMultiply(chunk ^ 0xe7037ed1a0b428dbULL, seed ^ 0x8ebc6af09c88c6e3ULL);
+    }
+
+    // the last 1 to 8 bytes, zero padded
+    chunk = 0;
+    memcpy(&chunk, bytes, length);
+    return foldMultiply(chunk ^ 0xe7037ed1a0b428dbULL ^ seed, bidId.size() ^ 0x8ebc6af09c88c6e3ULL);
+#endif
+}
+
 // define a structure to hold bid information
 struct Bid {
     string bidId; // unique identifier
@@ -51,13 +182,21 @@ private:
     // Define structures to hold bids
     struct Node {
         Bid bid;
-        unsigned int key;
+        uint64_t hashCode;
         Node *next;
 
+        // place of the bid in the fund index
+        uint32_t rowId;
+        uint32_t fundCode;
+        uint32_t postingPos;
+
         // default constructor
         Node() {
-            key = UINT_MAX;
+            hashCode = 0;
             next = nullptr;
+            rowId = 0;
+            fundCode = 0;
+            postingPos = 0;
         }
 
         // initialize with a bid
@@ -66,27 +205,168 @@ private:
             next = nullptr;
         }
 
-        // initialize with a bid and a key
-        Node(Bid aBid, unsigned int aKey) : Node(aBid) {
-            key = aKey;
+        // initialize with a bid and the hash of its id
+        Node(Bid aBid, uint64_t aHashCode) : Node(aBid) {
+            hashCode = aHashCode;
             next = nullptr;
         }
     };
 
-    vector<Node> nodes;
+    // each bucket points at the first node of its chain (or nullptr)
+    vector<Node*> nodes;
 
     unsigned int tableSize = DEFAULT_SIZE;
 
-    unsigned int hash(int key);
+    // number of bids stored in the table
+    unsigned int size = 0;
+
+    unsigned int hash(uint64_t hashCode);
+
+    // helper functions used when growing the table
+    static unsigned int nextPrime(unsigned int n);
+    void rehash(unsigned int newSize);
+    void placeNode(Node* node);
+
+    // buckets still being drained by an incremental rehash
+    vector<Node*> oldNodes;
+    unsigned int rehashIndex = 0;
+    bool incrementalRehash = false;
+
+    unsigned int hashOld(uint64_t hashCode);
+    void rehashStep(unsigned int buckets);
+    void finishRehash();
+
+    // bumped whenever bids move to different buckets, so cursors can
+    // tell their bucket and depth no longer mean the same place
+    unsigned int layoutGeneration = 0;
+
+    // scans see the new array's chains followed by the old array's,
+    // so they never have to wait for a migration to finish
+    size_t chainCount();
+    Node* chainAt(size_t chain);
+
+    // helper functions that work on either bucket array
+    Node* findIn(vector<Node*>& buckets, unsigned int index, uint64_t hashCode, string_view bidId);
+    bool removeFrom(vector<Node*>& buckets, unsigned int index, uint64_t hashCode, string_view bidId);
+
+    // the bids of one fund: row ids in no particular order and the
+    // running total of their amounts
+    struct FundPostings {
+        vector<uint32_t> rows;
+        double amountSum = 0.0;
+    };
+
+    // secondary index on fund. Each fund name gets a small dictionary
+    // code; each bid gets a row id, so a posting list holds 4-byte ids
+    // rather than pointers. Row ids of removed bids are reused.
+    deque<string> fundNames;
+    unordered_map<string_view, uint32_t> fundCodes;
+    vector<FundPostings> funds;
+    vector<Node*> rowNodes;
+    vector<uint32_t> freeRows;
+
+    void indexNode(Node* node);
+    void unindexNode(Node* node);
+    const FundPostings* postingsFor(string_view fund);
+
+public:
+    // ways of turning a bid id into a hash code
+    enum HashMode {
+        HASH_MODULO,    // the numeric value of the id
+        HASH_STRING     // hashBidId over the id's characters
+    };
+
+private:
+    HashMode hashMode = HASH_MODULO;
+
+    uint64_t hashCodeOf(string_view bidId);
 
 public:
     HashTable();
     HashTable(unsigned int size);
     virtual ~HashTable();
     void Insert(Bid bid);
+    size_t BulkInsert(const vector<Bid>& bids);
     void PrintAll();
     void Remove(string bidId);
+    bool Erase(string_view bidId);
     Bid Search(string bidId);
+    const Bid* Find(string_view bidId);
+
+    // queries answered from the fund index
+    size_t FindByFund(string_view fund, vector<const Bid*>& results);
+    unsigned int CountByFund(string_view fund);
+    double SumByFund(string_view fund);
+    size_t SearchBatch(const vector<string>& bidIds, vector<Bid>& results);
+
+    // sizing functions
+    void Reserve(unsigned int count);
+    void SetIncrementalRehash(bool enabled);
+    void SetHashMode(HashMode mode);
+    bool Rehashing();
+    unsigned int Size();
+    unsigned int BucketCount();
+    float LoadFactor();
+
+    /**
+     * Snapshot of how healthy the table is. Probe counts are the number
+     * of nodes a search compares against: a successful search for the
+     * k-th node of a chain makes k probes, and an unsuccessful search
+     * walks its whole chain. Miss figures assume misses hash into the
+     * buckets in the same proportion as the stored bids. During an
+     * incremental rehash the chain figures describe the new array, and
+     * a search also walks the old bucket when the new one misses.
+     */
+    struct Stats {
+        unsigned int bidCount = 0;
+        unsigned int bucketCount = 0;
+        float loadFactor = 0.0f;
+        unsigned int usedBuckets = 0;
+
+        // chainHistogram[k] is the number of buckets holding k bids
+        vector<unsigned int> chainHistogram;
+        double chainVariance = 0.0;
+
+        double averageHitProbes = 0.0;
+        unsigned int maxHitProbes = 0;
+        double averageMissProbes = 0.0;
+        unsigned int maxMissProbes = 0;
+
+        // bucket arrays, nodes and the string bytes they own, plus the
+        // fund index and its name dictionary
+        size_t memoryBytes = 0;
+    };
+
+    Stats GetStats();
+    void PrintStats();
+
+    /**
+     * Resumable position in the table used for paging.
+     * Bids are visited bucket by bucket in the same order as PrintAll;
+     * during an incremental rehash the buckets still waiting in the old
+     * array follow the new ones. The cursor stores a bucket and an
+     * offset into its chain, so it stays usable after inserts and
+     * removes, although rows may then shift by one. Growing the table,
+     * each migration step and changing the hash mode move bids to other
+     * buckets; the next Fetch notices and seeks back to the cursor's
+     * position in the new order.
+     */
+    class Cursor {
+        friend class HashTable;
+        size_t bucket = 0;
+        unsigned int depth = 0;
+        size_t position = 0;
+        bool atEnd = false;
+        unsigned int generation = 0;
+    public:
+        bool AtEnd() const { return atEnd; }
+        size_t Position() const { return position; }
+    };
+
+    // cursor functions for paging through the table without printing
+    Cursor Begin();
+    Cursor Seek(size_t position);
+    size_t Fetch(Cursor& cursor, size_t count, vector<Bid>& rows);
 };
 
 using std::cout;
@@ -97,7 +377,7 @@ using std::cout;
 HashTable::HashTable() {
 
     // Initalize node structure by resizing tableSize
-    nodes.resize(tableSize);
+    nodes.resize(tableSize, nullptr);
 }
 
 /**
@@ -109,7 +389,7 @@ HashTable::HashTable(unsigned int size) {
 
     // initialize tableSize with size parameter and resize the table
     tableSize = size;
-    nodes.resize(tableSize);
+    nodes.resize(tableSize, nullptr);
 }
 
 
@@ -118,24 +398,275 @@ HashTable::HashTable(unsigned int size) {
  */
 HashTable::~HashTable() {
 
+    // delete every chain in both bucket arrays
+    for (vector<Node*>* buckets : { &nodes, &oldNodes }) {
+        for (Node* temp : *buckets) {
+            while (temp != nullptr) {
+                Node* next = temp->next;
+                delete temp;
+                temp = next;
+            }
+        }
+    }
+
     // erase all nodes in vector of nodes
     nodes.erase(nodes.begin(), nodes.end());
 }
 
 /**
- * Calculate the hash value of a given key.
- * Note that key is specifically defined as
- * unsigned int to prevent undefined results
- * of a negative list index.
+ * Calculate the hash code of a bid id in the current hash mode.
+ * It is computed once per operation and cached in the node.
+ *
+ * @param bidId The bid id to hash
+ * @return The hash code
+ */
+uint64_t HashTable::hashCodeOf(string_view bidId) {
+    if (hashMode == HASH_STRING) {
+        return hashBidId(bidId);
+    }
+
+    // the numeric id read the way atoi reads it (the view need not be
+    // null terminated); non-numeric ids all map to 0
+    size_t i = 0;
+    while (i < bidId.size() && isspace((unsigned char)bidId[i])) {
+        ++i;
+    }
+    bool negative = i < bidId.size() && bidId[i] == '-';
+    if (i < bidId.size() && (bidId[i] == '-' || bidId[i] == '+')) {
+        ++i;
+    }
+    unsigned int value = 0;
+    for (; i < bidId.size() && isdigit((unsigned char)bidId[i]); ++i) {
+        value = value * 10 + (bidId[i] - '0');
+    }
+    return negative ? 0u - value : value;
+}
+
+/**
+ * Calculate the bucket of a given hash code.
+ * Note that the code is unsigned to prevent
+ * undefined results of a negative list index.
+ *
+ * @param hashCode The hash code of the bid id
+ * @return The bucket index
+ */
+unsigned int HashTable::hash(uint64_t hashCode) {
+
+    // return the hash value determined by the code modulus tableSize
+    return hashCode % tableSize;
+
+}
+
+/**
+ * Calculate the bucket of a hash code in the array being drained
+ *
+ * @param hashCode The hash code of the bid id
+ * @return The bucket index in the old array
+ */
+unsigned int HashTable::hashOld(uint64_t hashCode) {
+    return hashCode % oldNodes.size();
+}
+
+/**
+ * Returns the smallest prime number that is at least n.
+ * Prime table sizes spread sequential bid ids evenly under key % size.
+ */
+unsigned int HashTable::nextPrime(unsigned int n) {
+    if (n <= 2) {
+        return 2;
+    }
+    if (n % 2 == 0) {
+        ++n;
+    }
+    while (true) {
+        bool prime = true;
+        for (unsigned int d = 3; d * d <= n; d += 2) {
+            if (n % d == 0) {
+                prime = false;
+                break;
+            }
+        }
+        if (prime) {
+            return n;
+        }
+        n += 2;
+    }
+}
+
+/**
+ * Link an existing node into its bucket in the current array.
+ * The node caches its hash code, so the id is not hashed again.
+ *
+ * @param node the node to place
+ */
+void HashTable::placeNode(Node* node) {
+    unsigned int bucket = hash(node->hashCode);
+    node->next = nodes.at(bucket);
+    nodes.at(bucket) = node;
+}
+
+/**
+ * Move every bid into a new bucket array of the given size.
+ * In incremental mode the old array is kept and drained a few buckets
+ * at a time by later operations; otherwise it is drained right away.
+ * Buckets only hold chain pointers, so the new array is cheap to set up
+ * and the nodes themselves are relinked, never copied.
+ *
+ * @param newSize the new number of buckets
+ */
+void HashTable::rehash(unsigned int newSize) {
+
+    // only one migration runs at a time
+    finishRehash();
+
+    oldNodes.swap(nodes);
+    rehashIndex = 0;
+
+    tableSize = newSize;
+    nodes.assign(tableSize, nullptr);
+    ++layoutGeneration;
+
+    if (!incrementalRehash) {
+        finishRehash();
+    }
+}
+
+/**
+ * Migrate a bounded number of buckets from the old array
+ *
+ * @param buckets maximum number of old buckets to migrate
+ */
+void HashTable::rehashStep(unsigned int buckets) {
+
+    if (oldNodes.empty()) {
+        return;
+    }
+    ++layoutGeneration;
+
+    for (unsigned int i = 0; i < buckets && rehashIndex < oldNodes.size(); ++i, ++rehashIndex) {
+        Node* chain = oldNodes.at(rehashIndex);
+        oldNodes.at(rehashIndex) = nullptr;
+
+        while (chain != nullptr) {
+            Node* next = chain->next;
+            placeNode(chain);
+            chain = next;
+        }
+    }
+
+    // release the old array once it has been drained
+    if (rehashIndex == oldNodes.size()) {
+        vector<Node*>().swap(oldNodes);
+        rehashIndex = 0;
+    }
+}
+
+/**
+ * Migrate everything left in the old array
+ */
+void HashTable::finishRehash() {
+    rehashStep(UINT_MAX);
+}
+
+/**
+ * Returns the number of chains a scan visits: every bucket of the new
+ * array, then every bucket of the old one while it is being drained
+ */
+size_t HashTable::chainCount() {
+    return nodes.size() + oldNodes.size();
+}
+
+/**
+ * Returns the first node of a chain in scan order
+ *
+ * @param chain index below chainCount()
+ */
+HashTable::Node* HashTable::chainAt(size_t chain) {
+    if (chain < nodes.size()) {
+        return nodes[chain];
+    }
+    return oldNodes[chain - nodes.size()];
+}
+
+/**
+ * Select whether growth moves all bids at once or spreads the work
+ * over later Insert, Search and Remove calls (a few buckets each)
+ *
+ * @param enabled true for incremental rehashing
+ */
+void HashTable::SetIncrementalRehash(bool enabled) {
+    incrementalRehash = enabled;
+    if (!enabled) {
+        finishRehash();
+    }
+}
+
+/**
+ * Select how bid ids are turned into hash codes. A table that already
+ * holds bids rehashes every node with the new function.
+ *
+ * @param mode HASH_MODULO or HASH_STRING
+ */
+void HashTable::SetHashMode(HashMode mode) {
+    if (mode == hashMode) {
+        return;
+    }
+
+    finishRehash();
+    hashMode = mode;
+    ++layoutGeneration;
+
+    // unlink every chain, then place each node by its new code
+    vector<Node*> chains(tableSize, nullptr);
+    chains.swap(nodes);
+    for (Node* chain : chains) {
+        while (chain != nullptr) {
+            Node* next = chain->next;
+            chain->hashCode = hashCodeOf(chain->bid.bidId);
+            placeNode(chain);
+            chain = next;
+        }
+    }
+}
+
+/**
+ * Returns true while an incremental rehash is in progress
+ */
+bool HashTable::Rehashing() {
+    return !oldNodes.empty();
+}
+
+/**
+ * Grow the table so count bids fit without passing the load factor.
+ * Use before a bulk load so the table is only rehashed once.
  *
- * @param key The key to hash
- * @return The calculated hash
+ * @param count number of bids the table should hold
+ */
+void HashTable::Reserve(unsigned int count) {
+    if (count > tableSize * MAX_LOAD_FACTOR) {
+        rehash(nextPrime(count / MAX_LOAD_FACTOR + 1));
+    }
+}
+
+/**
+ * Returns the number of bids in the table
  */
-unsigned int HashTable::hash(int key) {
+unsigned int HashTable::Size() {
+    return size;
+}
 
-    // return the hash value determined by the key modulus tableSize
-    return key % tableSize;
+/**
+ * Returns the number of buckets in the table
+ */
+unsigned int HashTable::BucketCount() {
+    return tableSize;
+}
 
+/**
+ * Returns the average number of bids per bucket
+ */
+float HashTable::LoadFactor() {
+    return size * 1.0f / tableSize;
 }
 
 /**
@@ -145,22 +676,26 @@ unsigned int HashTable::hash(int key) {
  */
 void HashTable::Insert(Bid bid) {
 
-    // create variable to store the hash of the bidid
-    unsigned key = hash(std::stoi(bid.bidId));
+    // move a few buckets along if a rehash is in progress
+    rehashStep(REHASH_STEP_BUCKETS);
+
+    // double the bucket count before the load factor is passed
+    if (size + 1 > tableSize * MAX_LOAD_FACTOR) {
+        rehash(nextPrime(tableSize * 2));
+    }
+
+    // create the node; it keeps the hash code of the bidid for rehashing
+    Node* newNode = new Node(bid, hashCodeOf(bid.bidId));
+
+    // create variable to store the bucket of the bidid
+    unsigned key = hash(newNode->hashCode);
 
     // retrieve the node at that key
-    Node* node = &nodes.at(key);
+    Node* node = nodes.at(key);
 
-    // if there is no entry, then assign the node here
+    // if there is no entry, then the new node starts the chain
     if (node == nullptr) {
-        this->nodes.assign(key, bid);
-    }
-
-    // else, set the node with the key and bid, and assign next pointer to null
-    else if (node->key == UINT_MAX) {
-        node->key = key;
-        node->next = nullptr;
-        node->bid = bid;
+        nodes.at(key) = newNode;
     }
 
     // else, walk the list until we get to the next open node
@@ -169,239 +704,2977 @@ void HashTable::Insert(Bid bid) {
             node = node->next;
         }
 
-        // assign the node to the end of the vector at this bucket
-        node->next = new Node(bid, key);
+        // assign the node to the end of the chain at this bucket
+        node->next = newNode;
 
     }
+
+    // add the bid to the fund index
+    indexNode(newNode);
+
+    // increment the number of bids
+    size += 1;
 }
 
 /**
- * Print all bids
+ * Insert many bids at once using every core.
+ *
+ * The table is sized once up front. The rows are then handled in three
+ * parallel passes: each thread creates and hashes the nodes for its
+ * slice of the rows and counts how many fall in each bucket range;
+ * each thread copies its node pointers into a shared array grouped by
+ * bucket range; and each thread links one bucket range into the table.
+ * Bucket ranges don't overlap, so the last pass needs no locking.
+ * Rows keep their input order within a chain, as with Insert.
+ *
+ * Linking walks each chain to its tail anyway, so an id that is already
+ * in the table, or repeated earlier in bids, is skipped there.
+ *
+ * @param bids the bids to insert
+ * @return number of bids added
  */
-void HashTable::PrintAll() {
+size_t HashTable::BulkInsert(const vector<Bid>& bids) {
 
-    // set a count variable
-    int count = 0;
+    // size the table once and finish any migration so only nodes is used
+    Reserve(size + bids.size());
+    finishRehash();
 
-    // loop through the nodes
-    for (int i = 0; i < nodes.size(); ++i) {
+    size_t rowCount = bids.size();
+    unsigned int threadCount = (unsigned int)min<size_t>(
+        max(1u, thread::hardware_concurrency()), rowCount / BULK_ROWS_PER_THREAD + 1);
 
-        // if the key is not an empty bucket, then start printing the nodes
-        if (nodes.at(i).key != UINT_MAX) {
-            std::cout << nodes.at(i).key << ":  " << nodes.at(i).bid.bidId << "\n";
-            count++;
-            
-            Node* temp = this->nodes.at(i).next;
+    // bucket range p covers buckets [p * tableSize / threadCount, ...)
+    auto rangeOf = [&](unsigned int bucket) {
+        return (unsigned int)((uint64_t)bucket * threadCount / tableSize);
+    };
 
-            // walk through the list of sub-nodes at this bucket
-            while (temp != nullptr) {
-                std::cout << "\t--> " << temp->bid.bidId << "\n";
-                count++;
-                temp = temp->next;
+    // run a pass with one call per thread index
+    auto runParallel = [&](const function<void(unsigned int)>& pass) {
+        vector<thread> workers;
+        for (unsigned int t = 1; t < threadCount; ++t) {
+            workers.emplace_back(pass, t);
+        }
+        pass(0);
+        for (thread& worker : workers) {
+            worker.join();
+        }
+    };
+
+    vector<Node*> created(rowCount);
+    vector<Node*> grouped(rowCount);
+
+    // counts[t][p] is the number of rows in slice t that land in range p
+    vector<vector<size_t>> counts(threadCount, vector<size_t>(threadCount, 0));
+
+    // pass 1: create and hash the nodes of each slice
+    runParallel([&](unsigned int t) {
+        for (size_t i = rowCount * t / threadCount; i < rowCount * (t + 1) / threadCount; ++i) {
+            created[i] = new Node(bids[i], hashCodeOf(bids[i].bidId));
+            ++counts[t][rangeOf(hash(created[i]->hashCode))];
+        }
+    });
+
+    // where each slice writes its rows for each range, and where each
+    // range starts; slices write in order so input order is kept
+    vector<vector<size_t>> offsets(threadCount, vector<size_t>(threadCount));
+    vector<size_t> rangeStart(threadCount + 1);
+    size_t offset = 0;
+    for (unsigned int p = 0; p < threadCount; ++p) {
+        rangeStart[p] = offset;
+        for (unsigned int t = 0; t < threadCount; ++t) {
+            offsets[t][p] = offset;
+            offset += counts[t][p];
+        }
+    }
+    rangeStart[threadCount] = offset;
+
+    // pass 2: group the node pointers by bucket range
+    runParallel([&](unsigned int t) {
+        vector<size_t>& next = offsets[t];
+        for (size_t i = rowCount * t / threadCount; i < rowCount * (t + 1) / threadCount; ++i) {
+            grouped[next[rangeOf(hash(created[i]->hashCode))]++] = created[i];
+        }
+    });
+
+    // pass 3: link each range into its own buckets
+    vector<size_t> added(threadCount, 0);
+    runParallel([&](unsigned int p) {
+        for (size_t i = rangeStart[p]; i < rangeStart[p + 1]; ++i) {
+            Node* newNode = grouped[i];
+            Node** link = &nodes[hash(newNode->hashCode)];
+            bool duplicate = false;
+
+            while (*link != nullptr && !duplicate) {
+                duplicate = (*link)->hashCode == newNode->hashCode && (*link)->bid.bidId == newNode->bid.bidId;
+                link = &(*link)->next;
+            }
+
+            if (duplicate) {
+                delete newNode;
+                grouped[i] = nullptr;
             }
+            else {
+                *link = newNode;
+                ++added[p];
+            }
+        }
+    });
+
+    // the fund index is shared by every range, so fill it afterwards
+    for (Node* newNode : grouped) {
+        if (newNode != nullptr) {
+            indexNode(newNode);
         }
     }
 
-    // output the final count
-    std::cout << "\nFinal count: " << count << "\n\n";
+    size_t total = 0;
+    for (size_t count : added) {
+        total += count;
+    }
+    size += total;
+    return total;
+}
+
+/**
+ * Add a node to the fund index, giving it a row id and a place in
+ * its fund's posting list
+ *
+ * @param node the node just linked into the table
+ */
+void HashTable::indexNode(Node* node) {
+
+    // look up the fund's dictionary code, adding the fund if it is new;
+    // the deque keeps each name in place, so the map can view it
+    auto code = fundCodes.find(node->bid.fund);
+    if (code == fundCodes.end()) {
+        fundNames.push_back(node->bid.fund);
+        code = fundCodes.emplace(fundNames.back(), (uint32_t)funds.size()).first;
+        funds.emplace_back();
+    }
+    node->fundCode = code->second;
+
+    // reuse the row id of a removed bid when there is one
+    if (freeRows.empty()) {
+        node->rowId = (uint32_t)rowNodes.size();
+        rowNodes.push_back(node);
+    }
+    else {
+        node->rowId = freeRows.back();
+        freeRows.pop_back();
+        rowNodes[node->rowId] = node;
+    }
+
+    FundPostings& postings = funds[node->fundCode];
+    node->postingPos = (uint32_t)postings.rows.size();
+    postings.rows.push_back(node->rowId);
+    postings.amountSum += node->bid.amount;
+}
+
+/**
+ * Take a node out of the fund index. The last row of the posting list
+ * moves into its place, so removal takes constant time.
+ *
+ * @param node the node about to be deleted
+ */
+void HashTable::unindexNode(Node* node) {
+
+    FundPostings& postings = funds[node->fundCode];
+    uint32_t lastRow = postings.rows.back();
+    postings.rows[node->postingPos] = lastRow;
+    rowNodes[lastRow]->postingPos = node->postingPos;
+    postings.rows.pop_back();
+
+    // start an emptied fund from an exact zero rather than a rounding error
+    postings.amountSum = postings.rows.empty() ? 0.0 : postings.amountSum - node->bid.amount;
+
+    rowNodes[node->rowId] = nullptr;
+    freeRows.push_back(node->rowId);
+}
+
+/**
+ * Returns the posting list of a fund, or nullptr for an unknown fund
+ */
+const HashTable::FundPostings* HashTable::postingsFor(string_view fund) {
+    auto code = fundCodes.find(fund);
+    if (code == fundCodes.end()) {
+        return nullptr;
+    }
+    return &funds[code->second];
+}
+
+/**
+ * Collect every bid of a fund without scanning the table
+ *
+ * @param fund the fund name, matched exactly
+ * @param results the stored bids are appended here; each stays valid
+ *                until its bid is removed
+ * @return number of bids appended
+ */
+size_t HashTable::FindByFund(string_view fund, vector<const Bid*>& results) {
+    const FundPostings* postings = postingsFor(fund);
+    if (postings == nullptr) {
+        return 0;
+    }
+
+    for (uint32_t row : postings->rows) {
+        results.push_back(&rowNodes[row]->bid);
+    }
+    return postings->rows.size();
+}
+
+/**
+ * Returns the number of bids of a fund
+ *
+ * @param fund the fund name, matched exactly
+ */
+unsigned int HashTable::CountByFund(string_view fund) {
+    const FundPostings* postings = postingsFor(fund);
+    return postings == nullptr ? 0 : (unsigned int)postings->rows.size();
+}
+
+/**
+ * Returns the total amount of the bids of a fund
+ *
+ * @param fund the fund name, matched exactly
+ */
+double HashTable::SumByFund(string_view fund) {
+    const FundPostings* postings = postingsFor(fund);
+    return postings == nullptr ? 0.0 : postings->amountSum;
+}
+
+/**
+ * Returns the heap bytes owned by a string; a short string stored
+ * inside the string object itself owns none
+ */
+size_t stringHeapBytes(const string& text) {
+    const char* bytes = text.data();
+    const char* object = (const char*)&text;
+    if (bytes >= object && bytes < object + sizeof(string)) {
+        return 0;
+    }
+    return text.capacity() + 1;
+}
+
+/**
+ * Walk every chain and collect the table statistics
+ *
+ * @return the statistics
+ */
+HashTable::Stats HashTable::GetStats() {
+
+    Stats stats;
+    stats.bidCount = size;
+    stats.bucketCount = tableSize;
+    stats.loadFactor = LoadFactor();
+    stats.memoryBytes = sizeof(HashTable) + (nodes.capacity() + oldNodes.capacity()) * sizeof(Node*);
+
+    // the fund index
+    stats.memoryBytes += rowNodes.capacity() * sizeof(Node*) + freeRows.capacity() * sizeof(uint32_t)
+        + funds.capacity() * sizeof(FundPostings);
+    for (const FundPostings& postings : funds) {
+        stats.memoryBytes += postings.rows.capacity() * sizeof(uint32_t);
+    }
+
+    // the fund name dictionary; each map node holds its entry, a next
+    // pointer and, in common implementations, the cached hash
+    for (const string& name : fundNames) {
+        stats.memoryBytes += sizeof(string) + stringHeapBytes(name);
+    }
+    stats.memoryBytes += fundCodes.bucket_count() * sizeof(void*)
+        + fundCodes.size() * (sizeof(pair<const string_view, uint32_t>) + 2 * sizeof(void*));
+
+    double hitProbes = 0.0;
+    double sumSquares = 0.0;
+    unsigned int newCount = 0;
+    vector<unsigned int> lengths(nodes.size(), 0);
+
+    for (size_t bucket = 0; bucket < nodes.size(); ++bucket) {
+        unsigned int length = 0;
+        for (Node* node = nodes[bucket]; node != nullptr; node = node->next) {
+            ++length;
+
+            // finding this node takes one probe per node up to it
+            hitProbes += length;
+
+            stats.memoryBytes += sizeof(Node) + stringHeapBytes(node->bid.bidId)
+                + stringHeapBytes(node->bid.title) + stringHeapBytes(node->bid.fund);
+        }
+
+        if (length >= stats.chainHistogram.size()) {
+            stats.chainHistogram.resize(length + 1, 0);
+        }
+        ++stats.chainHistogram[length];
+
+        stats.usedBuckets += length != 0;
+        stats.maxHitProbes = max(stats.maxHitProbes, length);
+        sumSquares += (double)length * length;
+        lengths[bucket] = length;
+        newCount += length;
+    }
+
+    // bids an incremental rehash has not moved yet; a search misses in
+    // the new bucket before it walks the old chain
+    for (Node* node : oldNodes) {
+        unsigned int depth = 0;
+        for (; node != nullptr; node = node->next) {
+            ++depth;
+            unsigned int probes = lengths[hash(node->hashCode)] + depth;
+            hitProbes += probes;
+            stats.maxHitProbes = max(stats.maxHitProbes, probes);
+
+            stats.memoryBytes += sizeof(Node) + stringHeapBytes(node->bid.bidId)
+                + stringHeapBytes(node->bid.title) + stringHeapBytes(node->bid.fund);
+        }
+    }
+
+    // chain lengths of the array being drained, if any
+    vector<unsigned int> oldLengths(oldNodes.size(), 0);
+    for (size_t bucket = 0; bucket < oldNodes.size(); ++bucket) {
+        for (Node* node = oldNodes[bucket]; node != nullptr; node = node->next) {
+            ++oldLengths[bucket];
+        }
+    }
+
+    // a miss walks its whole bucket, plus its old bucket during a rehash.
+    // Misses are taken to land where the stored bids do, so each bid's
+    // buckets count once: a crowded bucket draws more misses than an
+    // empty one
+    double missProbes = 0.0;
+    for (size_t chain = 0; chain < chainCount(); ++chain) {
+        for (Node* node = chainAt(chain); node != nullptr; node = node->next) {
+            unsigned int probes = lengths[hash(node->hashCode)];
+            if (!oldNodes.empty()) {
+                probes += oldLengths[hashOld(node->hashCode)];
+            }
+            missProbes += probes;
+            stats.maxMissProbes = max(stats.maxMissProbes, probes);
+        }
+    }
+
+    double mean = newCount * 1.0 / tableSize;
+    stats.chainVariance = sumSquares / tableSize - mean * mean;
+    stats.averageHitProbes = size == 0 ? 0.0 : hitProbes / size;
+    stats.averageMissProbes = size == 0 ? 0.0 : missProbes / size;
+
+    return stats;
+}
+
+/**
+ * Print the table statistics
+ */
+void HashTable::PrintStats() {
+
+    Stats stats = GetStats();
+
+    cout << "  bids: " << stats.bidCount << " | buckets: " << stats.bucketCount
+        << " | load factor: " << stats.loadFactor << endl;
+    cout << "  used buckets: " << stats.usedBuckets << " ("
+        << (stats.bucketCount == 0 ? 0.0 : stats.usedBuckets * 100.0 / stats.bucketCount) << "%)"
+        << " | chain variance: " << stats.chainVariance << endl;
+
+    cout << "  chain lengths:";
+    for (size_t length = 0; length < stats.chainHistogram.size(); ++length) {
+        if (stats.chainHistogram[length] != 0) {
+            cout << " " << length << ":" << stats.chainHistogram[length];
+        }
+    }
+    cout << endl;
+
+    cout << "  hit probes avg: " << stats.averageHitProbes << " max: " << stats.maxHitProbes
+        << " | miss probes avg: " << stats.averageMissProbes << " max: " << stats.maxMissProbes << endl;
+    cout << "  memory: " << stats.memoryBytes << " bytes ("
+        << (stats.bidCount == 0 ? 0.0 : stats.memoryBytes * 1.0 / stats.bidCount) << " per bid)" << endl;
+}
+
+/**
+ * Print all bids
+ */
+void HashTable::PrintAll() {
+
+    // set a count variable
+    int count = 0;
+
+    // loop through the nodes, then any buckets an incremental rehash
+    // has not drained yet
+    for (size_t i = 0; i < chainCount(); ++i) {
+
+        // if the bucket is not empty, then start printing the nodes
+        if (chainAt(i) != nullptr) {
+            if (i < nodes.size()) {
+                std::cout << i << ":  " << chainAt(i)->bid.bidId << "\n";
+            }
+            else {
+                std::cout << "old " << i - nodes.size() << ":  " << chainAt(i)->bid.bidId << "\n";
+            }
+            count++;
+            
+            Node* temp = chainAt(i)->next;
+
+            // walk through the list of sub-nodes at this bucket
+            while (temp != nullptr) {
+                std::cout << "\t--> " << temp->bid.bidId << "\n";
+                count++;
+                temp = temp->next;
+            }
+        }
+    }
+
+    // output the final count
+    std::cout << "\nFinal count: " << count << "\n\n";
+}
+
+/**
+ * Remove a bid from one bucket of a bucket array
+ *
+ * @param buckets the bucket array to remove from
+ * @param bidIdKey the bucket the bid hashes to
+ * @param hashCode the hash code of the bid id
+ * @param bidId The bid id to search for
+ * @return true if the bid was found and removed
+ */
+bool HashTable::removeFrom(vector<Node*>& buckets, unsigned int bidIdKey, uint64_t hashCode, string_view bidId) {
+
+    // get the link that points at each node in turn,
+    // starting with the bucket itself
+    Node** link = &buckets.at(bidIdKey);
+
+    // walk the list until we find the correct bid
+    while (*link != nullptr) {
+        if (hashCode == (*link)->hashCode && bidId == (*link)->bid.bidId) {
+
+            // if we found it, then set it to a temp variable and re-assign the pointer
+            Node* temp = *link;
+            *link = temp->next;
+
+            // drop it from the fund index
+            unindexNode(temp);
+
+            // now delete it
+            delete temp;
+            temp = nullptr;
+            size -= 1;
+
+            return true;
+        }
+
+        link = &(*link)->next;
+    }
+
+    return false;
+}
+
+/**
+ * Remove a bid
+ *
+ * @param bidId The bid id to search for
+ */
+void HashTable::Remove(string bidId) {
+    if (Erase(bidId)) {
+        cout << "\n\n\t[[ " << bidId << " deleted ]]\n\n";
+    }
+}
+
+/**
+ * Remove a bid without printing anything
+ *
+ * @param bidId The bid id to search for
+ * @return true if the bid was found and removed
+ */
+bool HashTable::Erase(string_view bidId) {
+
+    // move a few buckets along if a rehash is in progress
+    rehashStep(REHASH_STEP_BUCKETS);
+
+    // create a variable to store the hash code of the bidid
+    uint64_t code = hashCodeOf(bidId);
+
+    // the bid is in the new array, or else still in the old one
+    if (removeFrom(nodes, this->hash(code), code, bidId)) {
+        return true;
+    }
+    return !oldNodes.empty() && removeFrom(oldNodes, hashOld(code), code, bidId);
+}
+
+/**
+ * Find a bid in one bucket of a bucket array
+ *
+ * @param buckets the bucket array to search
+ * @param bidIdKey the bucket the bid hashes to
+ * @param hashCode the hash code of the bid id
+ * @param bidId The bid id to search for
+ * @return the node holding the bid, or nullptr
+ */
+HashTable::Node* HashTable::findIn(vector<Node*>& buckets, unsigned int bidIdKey, uint64_t hashCode, string_view bidId) {
+
+    // create pointer to the chain that matches the bid key
+    Node* temp = buckets.at(bidIdKey);
+
+    // walk the sublists looking for the bidId we are searching for
+    // if we find it, then return the respective node; comparing the
+    // cached codes first skips most string compares
+    while (temp != nullptr) {
+        if (temp->hashCode == hashCode && temp->bid.bidId == bidId) {
+            return temp;
+        }
+
+        temp = temp->next;
+    }
+
+    // if we walk the whole list and don't find the bid, then return null
+    return nullptr;
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ */
+Bid HashTable::Search(string bidId) {
+    Bid bid;
+
+    // if the bid was found, then return a copy; otherwise return the dummy bid
+    const Bid* found = Find(bidId);
+    if (found != nullptr) {
+        return *found;
+    }
+    return bid;
+}
+
+/**
+ * Find the specified bidId without copying the key or the bid.
+ * Nodes are relinked but never moved when the table grows, so the
+ * pointer stays valid until the bid is removed.
+ *
+ * @param bidId The bid id to search for
+ * @return the stored bid, or nullptr if it is not present
+ */
+const Bid* HashTable::Find(string_view bidId) {
+
+    // move a few buckets along if a rehash is in progress
+    rehashStep(REHASH_STEP_BUCKETS);
+
+    // hash the incoming bidId we are searching for
+    uint64_t code = hashCodeOf(bidId);
+
+    // look in the new array, and then in the one being drained
+    Node* found = findIn(nodes, this->hash(code), code, bidId);
+    if (found == nullptr && !oldNodes.empty()) {
+        found = findIn(oldNodes, hashOld(code), code, bidId);
+    }
+
+    if (found != nullptr) {
+        return &found->bid;
+    }
+    return nullptr;
+}
+
+/**
+ * Search for many bid ids at once. Keys are handled in groups of
+ * SEARCH_BATCH_SIZE: every key in a group is hashed and its bucket
+ * prefetched, then every chain head is prefetched, and only then are
+ * the chains walked. The cache misses of a group overlap instead of
+ * being paid one after another as in a loop over Search.
+ *
+ * @param bidIds the bid ids to search for
+ * @param results resized to match bidIds; a bid that is not found is
+ *                left empty, as Search returns it
+ * @return number of bids found
+ */
+size_t HashTable::SearchBatch(const vector<string>& bidIds, vector<Bid>& results) {
+
+    // move a few buckets along if a rehash is in progress
+    rehashStep(REHASH_STEP_BUCKETS);
+
+    results.assign(bidIds.size(), Bid());
+
+    uint64_t codes[SEARCH_BATCH_SIZE];
+    Node* heads[SEARCH_BATCH_SIZE];
+    size_t found = 0;
+
+    for (size_t start = 0; start < bidIds.size(); start += SEARCH_BATCH_SIZE) {
+        size_t count = min((size_t)SEARCH_BATCH_SIZE, bidIds.size() - start);
+
+        // hash every key in the group and prefetch its bucket
+        for (size_t i = 0; i < count; ++i) {
+            codes[i] = hashCodeOf(bidIds[start + i]);
+            prefetchLine(&nodes[hash(codes[i])]);
+        }
+
+        // read the chain heads and prefetch the first node of each
+        for (size_t i = 0; i < count; ++i) {
+            heads[i] = nodes[hash(codes[i])];
+            if (heads[i] != nullptr) {
+                prefetchLine(heads[i]);
+            }
+        }
+
+        // walk the chains, which are now mostly in cache
+        for (size_t i = 0; i < count; ++i) {
+            const string& bidId = bidIds[start + i];
+            Node* node = heads[i];
+            while (node != nullptr && !(node->hashCode == codes[i] && node->bid.bidId == bidId)) {
+                node = node->next;
+            }
+
+            // a bid not moved yet is still in the array being drained
+            if (node == nullptr && !oldNodes.empty()) {
+                node = findIn(oldNodes, hashOld(codes[i]), codes[i], bidId);
+            }
+
+            if (node != nullptr) {
+                results[start + i] = node->bid;
+                ++found;
+            }
+        }
+    }
+
+    return found;
+}
+
+/**
+ * Returns a cursor at the first bid in the table
+ */
+HashTable::Cursor HashTable::Begin() {
+    Cursor cursor;
+    cursor.generation = layoutGeneration;
+    return cursor;
+}
+
+/**
+ * Returns a cursor at the given position in PrintAll order
+ *
+ * @param position number of bids to skip
+ */
+HashTable::Cursor HashTable::Seek(size_t position) {
+
+    Cursor cursor;
+    cursor.generation = layoutGeneration;
+    size_t remaining = position;
+
+    // skip whole chains until the position falls inside one; a
+    // migration in progress is left alone and both arrays are walked
+    for (; cursor.bucket < chainCount(); ++cursor.bucket) {
+        size_t length = 0;
+        for (Node* node = chainAt(cursor.bucket); node != nullptr; node = node->next) {
+            ++length;
+        }
+
+        if (remaining < length) {
+            cursor.depth = remaining;
+            cursor.position = position;
+            return cursor;
+        }
+        remaining -= length;
+    }
+
+    cursor.position = position - remaining;
+    cursor.atEnd = true;
+    return cursor;
+}
+
+/**
+ * Copy up to count bids starting at the cursor and move the cursor
+ * past them, so the next call resumes where this one stopped
+ *
+ * @param cursor the cursor to read from and advance
+ * @param count maximum number of bids to return
+ * @param rows the bids are appended here
+ * @return number of bids appended
+ */
+size_t HashTable::Fetch(Cursor& cursor, size_t count, vector<Bid>& rows) {
+
+    // the bids were moved to other buckets since the cursor was made
+    if (cursor.generation != layoutGeneration) {
+        cursor = Seek(cursor.position);
+    }
+
+    size_t fetched = 0;
+
+    for (; cursor.bucket < chainCount(); ++cursor.bucket, cursor.depth = 0) {
+        Node* node = chainAt(cursor.bucket);
+
+        // move to the cursor's place in the chain
+        for (unsigned int i = 0; i < cursor.depth && node != nullptr; ++i) {
+            node = node->next;
+        }
+
+        while (node != nullptr && fetched < count) {
+            rows.push_back(node->bid);
+            node = node->next;
+            ++cursor.depth;
+            ++cursor.position;
+            ++fetched;
+        }
+
+        // the page filled up partway through this chain
+        if (node != nullptr) {
+            return fetched;
+        }
+        if (fetched == count) {
+            ++cursor.bucket;
+            cursor.depth = 0;
+            return fetched;
+        }
+    }
+
+    cursor.atEnd = true;
+    return fetched;
+}
+
+//============================================================================
+// Open-addressing Hash Table class definition
+//============================================================================
+
+// number of control bytes examined together when probing
+const unsigned int GROUP_WIDTH = 16;
+
+// control byte values; a full slot stores the low 7 bits of its hash
+const int8_t CTRL_EMPTY = -128;
+const int8_t CTRL_DELETED = -2;
+
+// index of the lowest set bit of a non-zero mask
+inline unsigned int lowestSetBit(unsigned int mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+/**
+ * Define a class containing data members and methods to implement
+ * an open-addressing hash table in the SwissTable style.
+ *
+ * Every slot has a one-byte control value holding a 7-bit fingerprint
+ * of its key's hash. A lookup compares the fingerprint against a whole
+ * group of 16 control bytes at once (one SSE2 compare where available)
+ * and only looks at the bids whose fingerprint matches, so most misses
+ * are decided without touching a key.
+ */
+class FlatHashTable {
+
+private:
+    vector<int8_t> ctrl;
+    vector<Bid> slots;
+    unsigned int size = 0;
+    unsigned int deleted = 0;
+
+    static size_t hashKey(const string& bidId);
+
+    // bitmask of the slots in a group whose control byte equals value
+    unsigned int matchByte(unsigned int group, int8_t value);
+
+    // bitmask of the slots in a group that are empty or deleted
+    unsigned int matchFree(unsigned int group);
+
+    // helper function to find the slot holding a key (or -1)
+    long findSlot(const string& bidId);
+
+    void rehash(unsigned int newCapacity);
+
+public:
+    FlatHashTable();
+    FlatHashTable(unsigned int capacity);
+    virtual ~FlatHashTable() {}
+    void Insert(Bid bid);
+    void PrintAll();
+    void Remove(string bidId);
+    Bid Search(string bidId);
+    unsigned int Size();
+};
+
+/**
+ * Default constructor
+ */
+FlatHashTable::FlatHashTable() : FlatHashTable(GROUP_WIDTH) {
+}
+
+/**
+ * Constructor for pre-sizing the table
+ *
+ * @param capacity minimum number of slots; rounded up to a power of two
+ */
+FlatHashTable::FlatHashTable(unsigned int capacity) {
+    unsigned int slotCount = GROUP_WIDTH;
+    while (slotCount < capacity) {
+        slotCount *= 2;
+    }
+    ctrl.assign(slotCount, CTRL_EMPTY);
+    slots.resize(slotCount);
+}
+
+/**
+ * Calculate the full hash of a key
+ */
+size_t FlatHashTable::hashKey(const string& bidId) {
+    return std::hash<string>()(bidId);
+}
+
+/**
+ * Compare one byte value against the 16 control bytes of a group
+ *
+ * @return bit i is set when slot i of the group matches
+ */
+unsigned int FlatHashTable::matchByte(unsigned int group, int8_t value) {
+    const int8_t* bytes = &ctrl[group * GROUP_WIDTH];
+#ifdef HASHTABLE_SSE2
+    __m128i groupBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(groupBytes, _mm_set1_epi8(value)));
+#else
+    unsigned int mask = 0;
+    for (unsigned int i = 0; i < GROUP_WIDTH; ++i) {
+        if (bytes[i] == value) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+#endif
+}
+
+/**
+ * Find the empty and deleted slots of a group
+ * (both have the sign bit set; full slots do not)
+ */
+unsigned int FlatHashTable::matchFree(unsigned int group) {
+    const int8_t* bytes = &ctrl[group * GROUP_WIDTH];
+#ifdef HASHTABLE_SSE2
+    __m128i groupBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+    return _mm_movemask_epi8(groupBytes);
+#else
+    unsigned int mask = 0;
+    for (unsigned int i = 0; i < GROUP_WIDTH; ++i) {
+        if (bytes[i] < 0) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+#endif
+}
+
+/**
+ * Probe groups starting at the key's home group until the key
+ * is found or a group with an empty slot ends the probe sequence
+ *
+ * @return the slot index, or -1 if the key is not present
+ */
+long FlatHashTable::findSlot(const string& bidId) {
+
+    size_t hash = hashKey(bidId);
+    int8_t fingerprint = hash & 0x7F;
+    unsigned int groupMask = ctrl.size() / GROUP_WIDTH - 1;
+    unsigned int group = (hash >> 7) & groupMask;
+
+    // quadratic probing over groups visits every group once
+    for (unsigned int step = 1; ; ++step) {
+        unsigned int candidates = matchByte(group, fingerprint);
+        while (candidates != 0) {
+            unsigned int i = lowestSetBit(candidates);
+            long slot = group * GROUP_WIDTH + i;
+            if (slots[slot].bidId == bidId) {
+                return slot;
+            }
+            candidates &= candidates - 1;
+        }
+
+        if (matchByte(group, CTRL_EMPTY) != 0 || step > groupMask) {
+            return -1;
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+/**
+ * Move every bid into a fresh array of the given capacity
+ * (also clears out deleted markers)
+ */
+void FlatHashTable::rehash(unsigned int newCapacity) {
+
+    vector<int8_t> oldCtrl;
+    vector<Bid> oldSlots;
+    oldCtrl.swap(ctrl);
+    oldSlots.swap(slots);
+
+    ctrl.assign(newCapacity, CTRL_EMPTY);
+    slots.resize(newCapacity);
+    size = 0;
+    deleted = 0;
+
+    for (size_t i = 0; i < oldCtrl.size(); ++i) {
+        if (oldCtrl[i] >= 0) {
+            Insert(std::move(oldSlots[i]));
+        }
+    }
+}
+
+/**
+ * Insert a bid, replacing the stored bid if the id is already present
+ *
+ * @param bid The bid to insert
+ */
+void FlatHashTable::Insert(Bid bid) {
+
+    long existing = findSlot(bid.bidId);
+    if (existing >= 0) {
+        slots[existing] = std::move(bid);
+        return;
+    }
+
+    // keep the table at most 7/8 full (counting deleted slots)
+    if ((size + deleted + 1) * 8 > ctrl.size() * 7) {
+        unsigned int capacity = ctrl.size();
+        rehash(size * 2 >= capacity ? capacity * 2 : capacity);
+    }
+
+    size_t hash = hashKey(bid.bidId);
+    unsigned int groupMask = ctrl.size() / GROUP_WIDTH - 1;
+    unsigned int group = (hash >> 7) & groupMask;
+
+    // take the first free slot along the probe sequence
+    for (unsigned int step = 1; ; ++step) {
+        unsigned int freeSlots = matchFree(group);
+        if (freeSlots != 0) {
+            long slot = group * GROUP_WIDTH + lowestSetBit(freeSlots);
+            if (ctrl[slot] == CTRL_DELETED) {
+                deleted -= 1;
+            }
+            ctrl[slot] = hash & 0x7F;
+            slots[slot] = std::move(bid);
+            size += 1;
+            return;
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+/**
+ * Print all bids
+ */
+void FlatHashTable::PrintAll() {
+
+    int count = 0;
+
+    for (size_t i = 0; i < ctrl.size(); ++i) {
+        if (ctrl[i] >= 0) {
+            std::cout << i << ":  " << slots[i].bidId << "\n";
+            count++;
+        }
+    }
+
+    std::cout << "\nFinal count: " << count << "\n\n";
+}
+
+/**
+ * Remove a bid
+ *
+ * @param bidId The bid id to search for
+ */
+void FlatHashTable::Remove(string bidId) {
+
+    long slot = findSlot(bidId);
+    if (slot < 0) {
+        return;
+    }
+
+    // a slot in a group with no empty slot may be part of another key's
+    // probe sequence, so it becomes a deleted marker instead of empty
+    unsigned int group = slot / GROUP_WIDTH;
+    if (matchByte(group, CTRL_EMPTY) != 0) {
+        ctrl[slot] = CTRL_EMPTY;
+    }
+    else {
+        ctrl[slot] = CTRL_DELETED;
+        deleted += 1;
+    }
+    slots[slot] = Bid();
+    size -= 1;
+
+    std::cout << "\n\n\t[[ " << bidId << " deleted ]]\n\n";
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ */
+Bid FlatHashTable::Search(string bidId) {
+
+    long slot = findSlot(bidId);
+    if (slot < 0) {
+        return Bid();
+    }
+    return slots[slot];
+}
+
+/**
+ * Returns the number of bids in the table
+ */
+unsigned int FlatHashTable::Size() {
+    return size;
+}
+
+//============================================================================
+// Perfect Hash Index class definition
+//============================================================================
+
+// share of the slots that hold a key; the rest are remapped below n
+const double MPH_LOAD_FACTOR = 0.99;
+
+// buckets per key are MPH_BUCKET_FACTOR / log2(n); fewer buckets make
+// a smaller index but slower pilot searches
+const double MPH_BUCKET_FACTOR = 5.0;
+
+// seeds tried before giving up on a key set
+const int MPH_MAX_ATTEMPTS = 8;
+
+/**
+ * Define a class containing data members and methods to implement a
+ * read-only index over a frozen set of bids using a minimal perfect
+ * hash in the style of PTHash.
+ *
+ * Keys are split into buckets, and each bucket stores a 16-bit pilot
+ * chosen at build time so that its keys land on slots no other key
+ * uses. Slots past the number of bids are remapped into the holes
+ * below it, so the bids fill a flat array with no gaps. A lookup
+ * hashes the id once, reads one pilot, and probes exactly one slot.
+ * A 16-bit fingerprint beside each slot turns away almost every id
+ * that was never frozen without touching the bid itself.
+ */
+class PerfectHashIndex {
+
+private:
+    vector<uint16_t> pilots;
+    vector<uint32_t> remap;
+    vector<uint16_t> fingerprints;
+    vector<Bid> bids;
+
+    uint64_t seed = 0;
+    size_t slotCount = 0;
+    size_t bucketCount = 0;
+    size_t denseBuckets = 0;
+
+    uint64_t keyHash(const string& bidId) const;
+    size_t bucketOf(uint64_t h) const;
+    size_t slotOf(uint64_t h, uint16_t pilot) const;
+
+    static uint16_t fingerprintOf(uint64_t h) {
+        return (uint16_t)(h >> 48);
+    }
+
+    // outcome of one build attempt
+    enum BuildResult {
+        BUILD_DONE,         // every key has a slot of its own
+        BUILD_NEW_SEED,     // two ids share a hash, or a bucket found no pilot
+        BUILD_DUPLICATE_ID  // the same id appears twice; no seed can help
+    };
+
+    BuildResult build(const vector<Bid>& rows);
+
+public:
+    bool Freeze(HashTable& table);
+    Bid Search(const string& bidId) const;
+    size_t Size() const;
+    double BitsPerKey() const;
+};
+
+/**
+ * Hash a bid id with the current seed. The seed goes into every round
+ * over the bytes, in the style of wyhash, so two ids that collide under
+ * one seed are separated by the next; seeding the output of hashBidId
+ * could never split ids that already share its hash.
+ */
+uint64_t PerfectHashIndex::keyHash(const string& bidId) const {
+    const char* bytes = bidId.data();
+    size_t length = bidId.size();
+    uint64_t chunk;
+
+    uint64_t h = seed ^ 0xa0761d6478bd642fULL ^ length;
+    for (; length > 8; bytes += 8, length -= 8) {
+        memcpy(&chunk, bytes, 8);
+        h = foldMultiply(chunk ^ 0xe7037ed1a0b428dbULL, h ^ 0x8ebc6af09c88c6e3ULL);
+    }
+
+    // the last 1 to 8 bytes, zero padded
+    chunk = 0;
+    memcpy(&chunk, bytes, length);
+    return foldMultiply(chunk ^ 0xe7037ed1a0b428dbULL ^ h, seed ^ bidId.size() ^ 0x8ebc6af09c88c6e3ULL);
+}
+
+/**
+ * Pick the bucket of a key hash. About 60% of the keys go to the first
+ * 30% of the buckets; crowded buckets are placed first while most slots
+ * are free, which keeps pilot searches short.
+ */
+size_t PerfectHashIndex::bucketOf(uint64_t h) const {
+    uint64_t low = h & 0xffffffffULL;
+    size_t sparseBuckets = bucketCount - denseBuckets;
+
+    if (sparseBuckets == 0 || (h >> 32) < (uint64_t)(0.6 * 4294967296.0)) {
+        return (size_t)((low * denseBuckets) >> 32);
+    }
+    return denseBuckets + (size_t)((low * sparseBuckets) >> 32);
+}
+
+/**
+ * Slot of a key hash under a given pilot, before remapping
+ */
+size_t PerfectHashIndex::slotOf(uint64_t h, uint16_t pilot) const {
+    return (h ^ foldMultiply(pilot + 1ULL, 0xc4ceb9fe1a85ec53ULL)) % slotCount;
+}
+
+/**
+ * Build the index over every bid currently in a table. The table is
+ * read through its cursor and left unchanged; later changes to the
+ * table are not seen by the index.
+ *
+ * @param table the table to freeze
+ * @return false if the table holds an id twice or no seed separated the keys
+ */
+bool PerfectHashIndex::Freeze(HashTable& table) {
+
+    vector<Bid> rows;
+    HashTable::Cursor cursor = table.Begin();
+    table.Fetch(cursor, table.Size(), rows);
+
+    for (int attempt = 0; attempt < MPH_MAX_ATTEMPTS; ++attempt) {
+        seed = foldMultiply(attempt + 1ULL, 0xa0761d6478bd642fULL);
+        BuildResult result = build(rows);
+        if (result == BUILD_DONE) {
+            return true;
+        }
+        if (result == BUILD_DUPLICATE_ID) {
+            break;
+        }
+    }
+
+    // leave an empty index that finds nothing
+    build(vector<Bid>());
+    return false;
+}
+
+/**
+ * Build the index with the current seed
+ *
+ * @param rows the bids to index
+ * @return whether the keys were placed, and if not, whether a new seed can help
+ */
+PerfectHashIndex::BuildResult PerfectHashIndex::build(const vector<Bid>& rows) {
+
+    size_t keyCount = rows.size();
+    slotCount = max<size_t>(1, (size_t)ceil(keyCount / MPH_LOAD_FACTOR));
+    bucketCount = max<size_t>(1, (size_t)ceil(MPH_BUCKET_FACTOR * keyCount / log2(keyCount + 2.0)));
+    denseBuckets = max<size_t>(1, (size_t)(bucketCount * 0.3));
+
+    // hash every key and group the keys by bucket (counting sort)
+    vector<uint64_t> hashes(keyCount);
+    vector<uint32_t> bucketStart(bucketCount + 1, 0);
+    for (size_t i = 0; i < keyCount; ++i) {
+        hashes[i] = keyHash(rows[i].bidId);
+        ++bucketStart[bucketOf(hashes[i]) + 1];
+    }
+    for (size_t b = 0; b < bucketCount; ++b) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+
+    // keys with equal hashes land on the same slot under every pilot;
+    // a new seed separates two different ids, but not one id twice
+    vector<uint32_t> byHash(keyCount);
+    for (size_t i = 0; i < keyCount; ++i) {
+        byHash[i] = (uint32_t)i;
+    }
+    sort(byHash.begin(), byHash.end(), [&](uint32_t a, uint32_t b) {
+        return hashes[a] < hashes[b];
+    });
+    for (size_t i = 1; i < keyCount; ++i) {
+        uint32_t a = byHash[i - 1];
+        uint32_t b = byHash[i];
+        if (hashes[a] == hashes[b]) {
+            return rows[a].bidId == rows[b].bidId ? BUILD_DUPLICATE_ID : BUILD_NEW_SEED;
+        }
+    }
+
+    vector<uint32_t> keysByBucket(keyCount);
+    vector<uint32_t> next(bucketStart.begin(), bucketStart.end() - 1);
+    for (size_t i = 0; i < keyCount; ++i) {
+        keysByBucket[next[bucketOf(hashes[i])]++] = (uint32_t)i;
+    }
+
+    // place the largest buckets first
+    vector<uint32_t> order(bucketCount);
+    for (size_t b = 0; b < bucketCount; ++b) {
+        order[b] = (uint32_t)b;
+    }
+    stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return bucketStart[a + 1] - bucketStart[a] > bucketStart[b + 1] - bucketStart[b];
+    });
+
+    pilots.assign(bucketCount, 0);
+    vector<bool> taken(slotCount, false);
+    vector<size_t> slots(keyCount);
+    vector<size_t> trial;
+
+    for (uint32_t b : order) {
+        uint32_t first = bucketStart[b];
+        uint32_t last = bucketStart[b + 1];
+        if (first == last) {
+            break;
+        }
+
+        // try pilots until every key of the bucket lands on its own free slot
+        bool placed = false;
+        for (uint32_t pilot = 0; pilot <= UINT16_MAX && !placed; ++pilot) {
+            trial.clear();
+            for (uint32_t k = first; k < last; ++k) {
+                size_t slot = slotOf(hashes[keysByBucket[k]], (uint16_t)pilot);
+                if (taken[slot] || find(trial.begin(), trial.end(), slot) != trial.end()) {
+                    break;
+                }
+                trial.push_back(slot);
+            }
+
+            if (trial.size() == last - first) {
+                for (uint32_t k = first; k < last; ++k) {
+                    slots[keysByBucket[k]] = trial[k - first];
+                    taken[trial[k - first]] = true;
+                }
+                pilots[b] = (uint16_t)pilot;
+                placed = true;
+            }
+        }
+
+        if (!placed) {
+            return BUILD_NEW_SEED;
+        }
+    }
+
+    // slots at or past keyCount are sent to the free slots below it
+    remap.assign(slotCount - min(slotCount, keyCount), 0);
+    size_t hole = 0;
+    for (size_t slot = keyCount; slot < slotCount; ++slot) {
+        if (taken[slot]) {
+            while (taken[hole]) {
+                ++hole;
+            }
+            remap[slot - keyCount] = (uint32_t)hole++;
+        }
+    }
+
+    // lay the bids out in slot order
+    bids.assign(keyCount, Bid());
+    fingerprints.assign(keyCount, 0);
+    for (size_t i = 0; i < keyCount; ++i) {
+        size_t slot = slots[i] < keyCount ? slots[i] : remap[slots[i] - keyCount];
+        bids[slot] = rows[i];
+        fingerprints[slot] = fingerprintOf(hashes[i]);
+    }
+
+    return BUILD_DONE;
+}
+
+/**
+ * Search for the specified bidId with a single probe
+ *
+ * @param bidId The bid id to search for
+ * @return a copy of the bid, or an empty bid if it is not present
+ */
+Bid PerfectHashIndex::Search(const string& bidId) const {
+
+    if (bids.empty()) {
+        return {};
+    }
+
+    uint64_t h = keyHash(bidId);
+    size_t slot = slotOf(h, pilots[bucketOf(h)]);
+    if (slot >= bids.size()) {
+        slot = remap[slot - bids.size()];
+    }
+
+    // an id that was never frozen still maps to some slot; the
+    // fingerprint and then the id itself reject it
+    if (fingerprints[slot] != fingerprintOf(h) || bids[slot].bidId != bidId) {
+        return {};
+    }
+    return bids[slot];
+}
+
+/**
+ * Returns the number of bids in the index
+ */
+size_t PerfectHashIndex::Size() const {
+    return bids.size();
+}
+
+/**
+ * Returns the bits per bid used by the hash function itself (pilots
+ * and remap table), not counting fingerprints or bids
+ */
+double PerfectHashIndex::BitsPerKey() const {
+    if (bids.empty()) {
+        return 0.0;
+    }
+    return (pilots.size() * 16.0 + remap.size() * 32.0) / bids.size();
+}
+
+//============================================================================
+// Cuckoo Hash Table class definition
+//============================================================================
+
+// slots in each cuckoo bucket
+const int CUCKOO_WAYS = 4;
+
+// displacements tried before an insert gives up on the buckets
+const int CUCKOO_MAX_KICKS = 500;
+
+// bids that can wait in the stash before the table grows
+const size_t CUCKOO_STASH_SIZE = 4;
+
+/**
+ * Define a class containing data members and methods to implement a
+ * bucketized cuckoo hash table.
+ *
+ * Every bid lives in one of exactly two buckets of four slots, so a
+ * search reads at most two buckets however full the table is. Each
+ * bucket fits one cache line: a 16-bit tag and an entry pointer per
+ * slot. Only a slot whose tag matches has its entry read. The second
+ * bucket is derived from the first and the tag alone (partial-key
+ * cuckoo hashing), so entries can be moved without reading their ids.
+ * An insert that finds both buckets full evicts a resident to its other
+ * bucket, repeating up to CUCKOO_MAX_KICKS times. A bid left over is
+ * kept in a small stash, and the table doubles when the stash is full.
+ */
+class CuckooHashTable {
+
+private:
+    // a stored bid and the hash of its id, kept for resizing
+    struct Entry {
+        Bid bid;
+        uint64_t hashCode;
+    };
+
+    // one cache line of slots; a slot is free when its entry is null
+    struct alignas(64) Bucket {
+        uint16_t tags[CUCKOO_WAYS] = {};
+        Entry* entries[CUCKOO_WAYS] = {};
+    };
+
+    vector<Bucket> buckets;
+    vector<Entry*> stash;
+    unsigned int size = 0;
+    mt19937 rng;
+
+    static uint16_t tagOf(uint64_t hashCode) {
+        return (uint16_t)(hashCode >> 48);
+    }
+    size_t firstBucket(uint64_t hashCode) const {
+        return hashCode & (buckets.size() - 1);
+    }
+    // the XOR term is forced odd, so a tag whose product masks to zero
+    // still gets a second bucket distinct from the first
+    size_t otherBucket(size_t bucket, uint16_t tag) const {
+        size_t mask = buckets.size() - 1;
+        return (bucket ^ (((tag * 0x5bd1e995ULL) & mask) | 1)) & mask;
+    }
+
+    bool placeInBucket(size_t bucket, Entry* entry);
+    bool place(Entry*& entry);
+    void grow();
+    Entry** findSlot(const string& bidId, uint64_t hashCode);
+
+public:
+    CuckooHashTable(unsigned int capacity = 64);
+    virtual ~CuckooHashTable();
+    void Insert(Bid bid);
+    bool Remove(const string& bidId);
+    Bid Search(const string& bidId);
+    unsigned int Size();
+};
+
+/**
+ * Constructor
+ *
+ * @param capacity minimum number of bids to hold before growing
+ */
+CuckooHashTable::CuckooHashTable(unsigned int capacity) : rng(42) {
+    size_t bucketCount = 1;
+    while (bucketCount * CUCKOO_WAYS < capacity) {
+        bucketCount *= 2;
+    }
+    buckets.resize(bucketCount);
+}
+
+/**
+ * Destructor
+ */
+CuckooHashTable::~CuckooHashTable() {
+    for (Bucket& bucket : buckets) {
+        for (Entry* entry : bucket.entries) {
+            delete entry;
+        }
+    }
+    for (Entry* entry : stash) {
+        delete entry;
+    }
+}
+
+/**
+ * Put an entry in a free slot of a bucket
+ *
+ * @return false if the bucket is full
+ */
+bool CuckooHashTable::placeInBucket(size_t bucket, Entry* entry) {
+    Bucket& b = buckets[bucket];
+    for (int slot = 0; slot < CUCKOO_WAYS; ++slot) {
+        if (b.entries[slot] == nullptr) {
+            b.tags[slot] = tagOf(entry->hashCode);
+            b.entries[slot] = entry;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Place an entry in one of its buckets, evicting residents as needed
+ *
+ * @param entry the entry to place; on failure it is set to the entry
+ *              left without a slot, which may be a different one
+ * @return false if no slot was found within CUCKOO_MAX_KICKS moves
+ */
+bool CuckooHashTable::place(Entry*& entry) {
+
+    size_t bucket = firstBucket(entry->hashCode);
+    if (placeInBucket(bucket, entry)) {
+        return true;
+    }
+    bucket = otherBucket(bucket, tagOf(entry->hashCode));
+    if (placeInBucket(bucket, entry)) {
+        return true;
+    }
+
+    // evict a random resident and move it to its other bucket
+    for (int kick = 0; kick < CUCKOO_MAX_KICKS; ++kick) {
+        int slot = rng() % CUCKOO_WAYS;
+        Bucket& b = buckets[bucket];
+        swap(entry, b.entries[slot]);
+        b.tags[slot] = tagOf(b.entries[slot]->hashCode);
+
+        bucket = otherBucket(bucket, tagOf(entry->hashCode));
+        if (placeInBucket(bucket, entry)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Double the bucket count and place every entry again
+ */
+void CuckooHashTable::grow() {
+
+    vector<Entry*> entries;
+    entries.reserve(size);
+    for (Bucket& bucket : buckets) {
+        for (Entry* entry : bucket.entries) {
+            if (entry != nullptr) {
+                entries.push_back(entry);
+            }
+        }
+    }
+    entries.insert(entries.end(), stash.begin(), stash.end());
+    stash.clear();
+
+    size_t bucketCount = buckets.size() * 2;
+
+    // a placement that still fails just means growing again
+    while (true) {
+        buckets.assign(bucketCount, Bucket());
+
+        bool placed = true;
+        for (Entry* entry : entries) {
+            Entry* homeless = entry;
+            if (!place(homeless)) {
+                if (stash.size() < CUCKOO_STASH_SIZE) {
+                    stash.push_back(homeless);
+                    continue;
+                }
+                placed = false;
+                break;
+            }
+        }
+        if (placed) {
+            return;
+        }
+
+        stash.clear();
+        bucketCount *= 2;
+    }
+}
+
+/**
+ * Find the slot that holds a bid id
+ *
+ * @return pointer to the slot's entry pointer, or nullptr
+ */
+CuckooHashTable::Entry** CuckooHashTable::findSlot(const string& bidId, uint64_t hashCode) {
+
+    uint16_t tag = tagOf(hashCode);
+    size_t first = firstBucket(hashCode);
+    size_t candidates[2] = { first, otherBucket(first, tag) };
+
+    for (size_t bucket : candidates) {
+        Bucket& b = buckets[bucket];
+        for (int slot = 0; slot < CUCKOO_WAYS; ++slot) {
+            if (b.tags[slot] == tag && b.entries[slot] != nullptr && b.entries[slot]->bid.bidId == bidId) {
+                return &b.entries[slot];
+            }
+        }
+    }
+
+    // the stash is empty almost all the time
+    for (Entry*& entry : stash) {
+        if (entry->hashCode == hashCode && entry->bid.bidId == bidId) {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Insert a bid, replacing any bid with the same id
+ *
+ * @param bid The bid to insert
+ */
+void CuckooHashTable::Insert(Bid bid) {
+
+    uint64_t hashCode = hashBidId(bid.bidId);
+    Entry** existing = findSlot(bid.bidId, hashCode);
+    if (existing != nullptr) {
+        (*existing)->bid = std::move(bid);
+        return;
+    }
+
+    Entry* entry = new Entry{ std::move(bid), hashCode };
+    size += 1;
+
+    // whatever can't be placed waits in the stash; a full stash grows the table
+    if (!place(entry)) {
+        stash.push_back(entry);
+        if (stash.size() > CUCKOO_STASH_SIZE) {
+            grow();
+        }
+    }
+}
+
+/**
+ * Remove a bid
+ *
+ * @param bidId The bid id to remove
+ * @return true if the bid was found and removed
+ */
+bool CuckooHashTable::Remove(const string& bidId) {
+
+    Entry** slot = findSlot(bidId, hashBidId(bidId));
+    if (slot == nullptr) {
+        return false;
+    }
+
+    delete *slot;
+    *slot = nullptr;
+    size -= 1;
+
+    // stash slots are not reused in place, so drop the empty one
+    stash.erase(remove(stash.begin(), stash.end(), nullptr), stash.end());
+    return true;
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ * @return a copy of the bid, or an empty bid if it is not present
+ */
+Bid CuckooHashTable::Search(const string& bidId) {
+    Entry** slot = findSlot(bidId, hashBidId(bidId));
+    if (slot == nullptr) {
+        return {};
+    }
+    return (*slot)->bid;
+}
+
+/**
+ * Returns the number of bids in the table
+ */
+unsigned int CuckooHashTable::Size() {
+    return size;
+}
+
+//============================================================================
+// Memory-mapped Bid Index class definition
+//============================================================================
+
+// identifies a bid index file and its layout version; version 2 files
+// hash ids with MappedBidIndex::fileHash on every build
+const char INDEX_MAGIC[8] = { 'B', 'I', 'D', 'I', 'N', 'D', 'E', 'X' };
+const uint32_t INDEX_VERSION = 2;
+
+// read back as a different value if the file came from a machine
+// with the other byte order
+const uint32_t INDEX_BYTE_ORDER = 0x01020304;
+
+/**
+ * Define a class containing data members and methods to implement a
+ * read-only bid index that lives in a file and is used straight from a
+ * memory mapping.
+ *
+ * The file holds a header, a power-of-two array of fixed-size buckets,
+ * the bid records grouped by bucket, and a block of string bytes. Every
+ * link is an index or byte offset relative to its section, never a
+ * pointer, so the file means the same thing wherever it is mapped.
+ * Opening only maps the file and checks the header, so the time to the
+ * first search does not depend on the number of bids; the page cache
+ * loads the parts that searches actually touch.
+ *
+ * The stored hashes come from a fixed hash function rather than
+ * hashBidId, whose result depends on the instruction set the program
+ * was built for, so a file saved by one build can be searched by any
+ * other.
+ */
+class MappedBidIndex {
+
+private:
+    // file header, at offset 0
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint64_t bucketCount;
+        uint64_t bidCount;
+        uint64_t bucketsOffset;
+        uint64_t recordsOffset;
+        uint64_t stringsOffset;
+        uint64_t fileSize;
+    };
+
+    // the records of a bucket are records[first, first + count)
+    struct Bucket {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    // one bid; the strings are byte ranges in the strings block
+    struct Record {
+        uint64_t hashCode;
+        double amount;
+        uint32_t idOffset;
+        uint32_t titleOffset;
+        uint32_t fundOffset;
+        uint16_t idLength;
+        uint16_t titleLength;
+        uint16_t fundLength;
+        uint16_t padding;
+    };
+
+    const char* data = nullptr;
+    size_t dataSize = 0;
+    const Header* header = nullptr;
+
+#ifdef _WIN32
+    HANDLE fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE mappingHandle = nullptr;
+#endif
+
+    static uint64_t fileHash(string_view bidId);
+    string readString(uint32_t offset, uint16_t length) const;
+
+public:
+    MappedBidIndex() {}
+    MappedBidIndex(const MappedBidIndex&) = delete;
+    MappedBidIndex& operator=(const MappedBidIndex&) = delete;
+    virtual ~MappedBidIndex();
+
+    static bool Save(HashTable& table, const string& path);
+    bool Open(const string& path);
+    void Close();
+    bool IsOpen() const;
+    Bid Search(const string& bidId) const;
+    size_t Size() const;
+};
+
+/**
+ * Destructor
+ */
+MappedBidIndex::~MappedBidIndex() {
+    Close();
+}
+
+/**
+ * 64-bit FNV-1a hash of an id, finished with a bit mixer. It uses only
+ * byte loads and 64-bit arithmetic, so it is part of the file format:
+ * changing it requires a new INDEX_VERSION.
+ */
+uint64_t MappedBidIndex::fileHash(string_view bidId) {
+    uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : bidId) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * Write every bid in a table to an index file. The file is written
+ * under a temporary name and renamed over path, so path always holds
+ * either the previous index or the complete new one.
+ *
+ * @param table the table to save; it is read through its cursor
+ * @param path the file to create or replace
+ * @return false if the file could not be written, or a bid does not
+ *         fit the format (a string over 65535 bytes, or over 4 GB of
+ *         strings in total)
+ */
+bool MappedBidIndex::Save(HashTable& table, const string& path) {
+
+    vector<Bid> bids;
+    HashTable::Cursor cursor = table.Begin();
+    table.Fetch(cursor, table.Size(), bids);
+
+    // records are numbered with 32-bit indexes
+    if (bids.size() > UINT32_MAX) {
+        return false;
+    }
+
+    // about one bid per bucket
+    uint64_t bucketCount = 1;
+    while (bucketCount < bids.size()) {
+        bucketCount *= 2;
+    }
+
+    // group the bids by bucket (counting sort)
+    vector<uint64_t> hashes(bids.size());
+    vector<Bucket> buckets(bucketCount, Bucket{ 0, 0 });
+    for (size_t i = 0; i < bids.size(); ++i) {
+        hashes[i] = fileHash(bids[i].bidId);
+        ++buckets[hashes[i] & (bucketCount - 1)].count;
+    }
+    uint32_t first = 0;
+    for (Bucket& bucket : buckets) {
+        bucket.first = first;
+        first += bucket.count;
+    }
+
+    vector<uint32_t> next(bucketCount);
+    for (uint64_t b = 0; b < bucketCount; ++b) {
+        next[b] = buckets[b].first;
+    }
+
+    // lay out the records and their strings; a string that does not fit
+    // its 16-bit length or 32-bit offset fails the save rather than being
+    // cut short, since a shortened id could never be found again
+    vector<Record> records(bids.size());
+    string strings;
+    auto appendString = [&](const string& text, uint32_t& offset, uint16_t& length) {
+        if (text.size() > UINT16_MAX || strings.size() + text.size() > UINT32_MAX) {
+            return false;
+        }
+        offset = (uint32_t)strings.size();
+        length = (uint16_t)text.size();
+        strings.append(text);
+        return true;
+    };
+
+    for (size_t i = 0; i < bids.size(); ++i) {
+        Record& record = records[next[hashes[i] & (bucketCount - 1)]++];
+        record = Record();
+        record.hashCode = hashes[i];
+        record.amount = bids[i].amount;
+        if (!appendString(bids[i].bidId, record.idOffset, record.idLength)
+            || !appendString(bids[i].title, record.titleOffset, record.titleLength)
+            || !appendString(bids[i].fund, record.fundOffset, record.fundLength)) {
+            return false;
+        }
+    }
+
+    Header fileHeader = {};
+    memcpy(fileHeader.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    fileHeader.version = INDEX_VERSION;
+    fileHeader.byteOrder = INDEX_BYTE_ORDER;
+    fileHeader.bucketCount = bucketCount;
+    fileHeader.bidCount = bids.size();
+    fileHeader.bucketsOffset = sizeof(Header);
+    fileHeader.recordsOffset = fileHeader.bucketsOffset + bucketCount * sizeof(Bucket);
+    fileHeader.stringsOffset = fileHeader.recordsOffset + records.size() * sizeof(Record);
+    fileHeader.fileSize = fileHeader.stringsOffset + strings.size();
+
+    string tempPath = path + ".tmp";
+    {
+        ofstream out(tempPath, ios::binary | ios::trunc);
+        out.write((const char*)&fileHeader, sizeof(fileHeader));
+        out.write((const char*)buckets.data(), buckets.size() * sizeof(Bucket));
+        out.write((const char*)records.data(), records.size() * sizeof(Record));
+        out.write(strings.data(), strings.size());
+        out.close();
+        if (!out) {
+            remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+    // get the bytes onto the disk before the rename makes them the index
+#ifdef _WIN32
+    bool replaced = MoveFileExA(tempPath.c_str(), path.c_str(),
+        MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    int fd = open(tempPath.c_str(), O_RDONLY);
+    bool replaced = fd >= 0 && fsync(fd) == 0;
+    if (fd >= 0) {
+        close(fd);
+    }
+    replaced = replaced && rename(tempPath.c_str(), path.c_str()) == 0;
+#endif
+
+    if (!replaced) {
+        remove(tempPath.c_str());
+    }
+    return replaced;
+}
+
+/**
+ * Map an index file and check its header
+ *
+ * @param path the index file to open
+ * @return false if the file is missing, unreadable or not an index
+ */
+bool MappedBidIndex::Open(const string& path) {
+
+    Close();
+
+#ifdef _WIN32
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(fileHandle, &length) || length.QuadPart < (LONGLONG)sizeof(Header)) {
+        Close();
+        return false;
+    }
+
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle == nullptr) {
+        Close();
+        return false;
+    }
+
+    data = (const char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr) {
+        Close();
+        return false;
+    }
+    dataSize = (size_t)length.QuadPart;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(Header)) {
+        close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+    // the mapping keeps the file open by itself
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    data = (const char*)mapping;
+    dataSize = info.st_size;
+#endif
+
+    // check the header before trusting any offset in it
+    header = (const Header*)data;
+    bool valid = memcmp(header->magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0
+        && header->version == INDEX_VERSION
+        && header->byteOrder == INDEX_BYTE_ORDER
+        && header->fileSize == dataSize
+        && header->bucketCount != 0
+        && (header->bucketCount & (header->bucketCount - 1)) == 0
+        && header->bucketsOffset == sizeof(Header)
+        && header->recordsOffset == header->bucketsOffset + header->bucketCount * sizeof(Bucket)
+        && header->stringsOffset == header->recordsOffset + header->bidCount * sizeof(Record)
+        && header->stringsOffset <= dataSize;
+
+    if (!valid) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Unmap the index file, if one is open
+ */
+void MappedBidIndex::Close() {
+#ifdef _WIN32
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+    }
+    if (mappingHandle != nullptr) {
+        CloseHandle(mappingHandle);
+        mappingHandle = nullptr;
+    }
+    if (fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle);
+        fileHandle = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (data != nullptr) {
+        munmap((void*)data, dataSize);
+    }
+#endif
+    data = nullptr;
+    dataSize = 0;
+    header = nullptr;
+}
+
+/**
+ * Returns true while an index file is mapped
+ */
+bool MappedBidIndex::IsOpen() const {
+    return header != nullptr;
+}
+
+/**
+ * Copy a string out of the strings block. A range outside the block
+ * (a damaged file) reads as an empty string.
+ */
+string MappedBidIndex::readString(uint32_t offset, uint16_t length) const {
+    uint64_t stringsSize = dataSize - header->stringsOffset;
+    if ((uint64_t)offset + length > stringsSize) {
+        return string();
+    }
+    return string(data + header->stringsOffset + offset, length);
+}
+
+/**
+ * Search for the specified bidId in the mapped file
+ *
+ * @param bidId The bid id to search for
+ * @return a copy of the bid, or an empty bid if it is not present
+ */
+Bid MappedBidIndex::Search(const string& bidId) const {
+
+    if (header == nullptr) {
+        return {};
+    }
+
+    uint64_t hashCode = fileHash(bidId);
+    const Bucket* buckets = (const Bucket*)(data + header->bucketsOffset);
+    const Record* records = (const Record*)(data + header->recordsOffset);
+    const Bucket& bucket = buckets[hashCode & (header->bucketCount - 1)];
+
+    for (uint64_t i = bucket.first; i < (uint64_t)bucket.first + bucket.count && i < header->bidCount; ++i) {
+        const Record& record = records[i];
+        if (record.hashCode != hashCode || record.idLength != bidId.size()) {
+            continue;
+        }
+        if (readString(record.idOffset, record.idLength) != bidId) {
+            continue;
+        }
+
+        Bid bid;
+        bid.bidId = bidId;
+        bid.title = readString(record.titleOffset, record.titleLength);
+        bid.fund = readString(record.fundOffset, record.fundLength);
+        bid.amount = record.amount;
+        return bid;
+    }
+
+    return {};
+}
+
+/**
+ * Returns the number of bids in the mapped file
+ */
+size_t MappedBidIndex::Size() const {
+    return header == nullptr ? 0 : header->bidCount;
+}
+
+//============================================================================
+// Sharded Hash Table class definition
+//============================================================================
+
+/**
+ * Define a class containing data members and methods to implement a
+ * hash table that many threads can use at once.
+ *
+ * The key space is split over independent shards, each a HashTable
+ * behind its own reader-writer lock. A bid id always maps to the same
+ * shard, so threads working on different shards never wait on each
+ * other, and searches within one shard share its lock. Each shard sits
+ * on its own cache lines so that taking one lock does not slow down
+ * threads using the neighbouring shard.
+ */
+class ShardedHashTable {
+
+private:
+    // one lock and the part of the table it protects
+    struct alignas(64) Shard {
+        shared_mutex lock;
+        HashTable table;
+    };
+
+    vector<Shard> shards;
+
+    Shard& shardFor(const string& bidId);
+
+public:
+    ShardedHashTable(unsigned int shardCount = 64);
+    void Insert(Bid bid);
+    bool InsertIfAbsent(Bid bid);
+    bool Remove(const string& bidId);
+    Bid Search(const string& bidId);
+    unsigned int Size();
+};
+
+/**
+ * Constructor
+ *
+ * @param shardCount number of independently locked shards
+ */
+ShardedHashTable::ShardedHashTable(unsigned int shardCount) : shards(max(1u, shardCount)) {
+
+    // shards hash the id's characters so ids spread evenly within one;
+    // incremental rehashing stays off because it would make Search write
+    for (Shard& shard : shards) {
+        shard.table.SetHashMode(HashTable::HASH_STRING);
+    }
+}
+
+/**
+ * Returns the shard a bid id belongs to. The high half of the hash
+ * picks the shard; the shard's table uses the whole hash for its bucket.
+ */
+ShardedHashTable::Shard& ShardedHashTable::shardFor(const string& bidId) {
+    uint64_t h = hashBidId(bidId);
+    return shards[((h >> 32) * shards.size()) >> 32];
+}
+
+/**
+ * Insert a bid
+ *
+ * @param bid The bid to insert
+ */
+void ShardedHashTable::Insert(Bid bid) {
+    Shard& shard = shardFor(bid.bidId);
+    unique_lock<shared_mutex> guard(shard.lock);
+    shard.table.Insert(bid);
+}
+
+/**
+ * Insert a bid unless its id is already present. The check and the
+ * insert happen under one hold of the shard's lock, so two threads
+ * adding the same id can't both succeed.
+ *
+ * @param bid The bid to insert
+ * @return true if the bid was inserted
+ */
+bool ShardedHashTable::InsertIfAbsent(Bid bid) {
+    Shard& shard = shardFor(bid.bidId);
+    unique_lock<shared_mutex> guard(shard.lock);
+    if (shard.table.Find(bid.bidId) != nullptr) {
+        return false;
+    }
+    shard.table.Insert(bid);
+    return true;
+}
+
+/**
+ * Remove a bid
+ *
+ * @param bidId The bid id to remove
+ * @return true if the bid was found and removed
+ */
+bool ShardedHashTable::Remove(const string& bidId) {
+    Shard& shard = shardFor(bidId);
+    unique_lock<shared_mutex> guard(shard.lock);
+    return shard.table.Erase(bidId);
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ * @return a copy of the bid, or an empty bid if it is not present
+ */
+Bid ShardedHashTable::Search(const string& bidId) {
+    Shard& shard = shardFor(bidId);
+    shared_lock<shared_mutex> guard(shard.lock);
+    return shard.table.Search(bidId);
+}
+
+/**
+ * Returns the number of bids in the table. Shards are counted one at
+ * a time, so the total is only exact while no thread is writing.
+ */
+unsigned int ShardedHashTable::Size() {
+    unsigned int total = 0;
+    for (Shard& shard : shards) {
+        shared_lock<shared_mutex> guard(shard.lock);
+        total += shard.table.Size();
+    }
+    return total;
+}
+
+//============================================================================
+// Lock-free read Hash Table class definition
+//============================================================================
+
+/**
+ * Define a class containing data members and methods to implement a
+ * hash table whose searches never lock.
+ *
+ * Readers pin an epoch and follow atomic links; they never write to
+ * the table or to any shared cache line. Writers take turns on a mutex
+ * and publish every change with a single atomic pointer store, so a
+ * reader sees a chain either before or after the change. Removed nodes
+ * are handed to an EpochReclaimer and freed once no reader can still
+ * be on them. Growing builds a new bucket array of copied nodes and
+ * swaps it in whole, since relinking nodes in place could make a
+ * reader on the old array miss a bid.
+ */
+class ConcurrentHashTable {
+
+private:
+    // Internal structure for table entries
+    struct Node {
+        Bid bid;
+        uint64_t hashCode;
+        atomic<Node*> next;
+
+        // initialize with a bid and the hash of its id
+        Node(Bid aBid, uint64_t aHashCode) : bid(aBid), hashCode(aHashCode), next(nullptr) {}
+    };
+
+    // bucket heads and their count, replaced as a whole when growing;
+    // the count is a power of two so a mask picks the bucket
+    struct BucketArray {
+        unsigned int size;
+        atomic<Node*>* heads;
+
+        BucketArray(unsigned int aSize) : size(aSize), heads(new atomic<Node*>[aSize]) {
+            for (unsigned int i = 0; i < size; ++i) {
+                heads[i].store(nullptr, memory_order_relaxed);
+            }
+        }
+        ~BucketArray() {
+            delete[] heads;
+        }
+
+        atomic<Node*>& bucketFor(uint64_t hashCode) {
+            return heads[hashCode & (size - 1)];
+        }
+    };
+
+    atomic<BucketArray*> buckets;
+    atomic<unsigned int> size{0};
+
+    // writers take turns; readers never touch it
+    mutex writeLock;
+    EpochReclaimer reclaimer;
+
+    static void deleteNode(void* p) {
+        delete static_cast<Node*>(p);
+    }
+    static void deleteBuckets(void* p);
+    void grow(EpochReclaimer::Guard& guard);
+
+public:
+    ConcurrentHashTable(unsigned int bucketCount = 256);
+    virtual ~ConcurrentHashTable();
+    bool Insert(Bid bid);
+    bool Remove(const string& bidId);
+    Bid Search(const string& bidId);
+    unsigned int Size();
+};
+
+/**
+ * Constructor
+ *
+ * @param bucketCount initial number of buckets, rounded up to a power of two
+ */
+ConcurrentHashTable::ConcurrentHashTable(unsigned int bucketCount) {
+    unsigned int rounded = 1;
+    while (rounded < bucketCount) {
+        rounded *= 2;
+    }
+    buckets.store(new BucketArray(rounded));
+}
+
+/**
+ * Destructor
+ * No thread can be using the table; retired nodes and arrays are freed
+ * by the reclaimer.
+ */
+ConcurrentHashTable::~ConcurrentHashTable() {
+    deleteBuckets(buckets.load());
+}
+
+/**
+ * Free a bucket array together with every node still linked into it
+ */
+void ConcurrentHashTable::deleteBuckets(void* p) {
+    BucketArray* array = static_cast<BucketArray*>(p);
+
+    for (unsigned int i = 0; i < array->size; ++i) {
+        Node* node = array->heads[i].load(memory_order_relaxed);
+        while (node != nullptr) {
+            Node* next = node->next.load(memory_order_relaxed);
+            delete node;
+            node = next;
+        }
+    }
+    delete array;
+}
+
+/**
+ * Double the bucket count. Called with the write lock held.
+ *
+ * @param guard the writer's epoch guard, used to retire the old array
+ */
+void ConcurrentHashTable::grow(EpochReclaimer::Guard& guard) {
+
+    BucketArray* old = buckets.load(memory_order_relaxed);
+    BucketArray* fresh = new BucketArray(old->size * 2);
+
+    // readers may still be walking the old chains, so copy every node
+    for (unsigned int i = 0; i < old->size; ++i) {
+        for (Node* node = old->heads[i].load(memory_order_relaxed); node != nullptr;
+            node = node->next.load(memory_order_relaxed)) {
+            Node* copy = new Node(node->bid, node->hashCode);
+            atomic<Node*>& head = fresh->bucketFor(copy->hashCode);
+            copy->next.store(head.load(memory_order_relaxed), memory_order_relaxed);
+            head.store(copy, memory_order_relaxed);
+        }
+    }
+
+    // publish the new array; the old one goes once readers move on
+    buckets.store(fresh, memory_order_release);
+    guard.Retire(old, deleteBuckets);
+}
+
+/**
+ * Insert a bid
+ *
+ * @param bid The bid to insert
+ * @return false if the bid id is already present
+ */
+bool ConcurrentHashTable::Insert(Bid bid) {
+
+    lock_guard<mutex> writer(writeLock);
+    EpochReclaimer::Guard guard = reclaimer.Pin();
+
+    uint64_t code = hashBidId(bid.bidId);
+
+    // duplicate bid ids are not allowed
+    for (Node* node = buckets.load(memory_order_relaxed)->bucketFor(code).load(memory_order_relaxed);
+        node != nullptr; node = node->next.load(memory_order_relaxed)) {
+        if (node->hashCode == code && node->bid.bidId == bid.bidId) {
+            return false;
+        }
+    }
+
+    // grow before the load factor is passed
+    if (size.load(memory_order_relaxed) + 1 > buckets.load(memory_order_relaxed)->size * MAX_LOAD_FACTOR) {
+        grow(guard);
+    }
+
+    // the node is complete before the release store makes it visible
+    atomic<Node*>& head = buckets.load(memory_order_relaxed)->bucketFor(code);
+    Node* newNode = new Node(bid, code);
+    newNode->next.store(head.load(memory_order_relaxed), memory_order_relaxed);
+    head.store(newNode, memory_order_release);
+
+    size.fetch_add(1, memory_order_relaxed);
+    return true;
+}
+
+/**
+ * Remove a bid
+ *
+ * @param bidId The bid id to remove
+ * @return true if the bid was found and removed
+ */
+bool ConcurrentHashTable::Remove(const string& bidId) {
+
+    lock_guard<mutex> writer(writeLock);
+    EpochReclaimer::Guard guard = reclaimer.Pin();
+
+    uint64_t code = hashBidId(bidId);
+    atomic<Node*>* link = &buckets.load(memory_order_relaxed)->bucketFor(code);
+
+    for (Node* node = link->load(memory_order_relaxed); node != nullptr;
+        link = &node->next, node = link->load(memory_order_relaxed)) {
+        if (node->hashCode == code && node->bid.bidId == bidId) {
+
+            // unlink with one store; a reader already on the node still
+            // finds the rest of the chain through its next link
+            link->store(node->next.load(memory_order_relaxed), memory_order_release);
+            guard.Retire(node, deleteNode);
+
+            size.fetch_sub(1, memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Search for the specified bidId without taking any lock
+ *
+ * @param bidId The bid id to search for
+ * @return a copy of the bid, or an empty bid if it is not present
+ */
+Bid ConcurrentHashTable::Search(const string& bidId) {
+
+    EpochReclaimer::Guard guard = reclaimer.Pin();
+
+    uint64_t code = hashBidId(bidId);
+    BucketArray* array = buckets.load(memory_order_acquire);
+
+    for (Node* node = array->bucketFor(code).load(memory_order_acquire); node != nullptr;
+        node = node->next.load(memory_order_acquire)) {
+        if (node->hashCode == code && node->bid.bidId == bidId) {
+            return node->bid;
+        }
+    }
+
+    // Return an empty bid if the key is not found
+    return {};
+}
+
+/**
+ * Returns the number of bids in the table
+ */
+unsigned int ConcurrentHashTable::Size() {
+    return size.load();
+}
+
+//============================================================================
+// Static methods used for testing
+//============================================================================
+
+
+Bid getBid() {
+    Bid bid;
+
+    cout << "Enter Id: ";
+    cin.ignore();
+    getline(cin, bid.bidId);
+
+    cout << "Enter title: ";
+    getline(cin, bid.title);
+
+    cout << "Enter fund: ";
+    getline(cin, bid.fund);
+
+    cout << "Enter amount: ";
+    cin.clear();
+    cin.ignore();
+    string strAmount;
+    getline(cin, strAmount);
+    bid.amount = strToDouble(strAmount, '$');
+
+    return bid;
+}
+
+
+
+/**
+ * Display the bid information to the console (std::out)
+ *
+ * @param bid struct containing the bid info
+ */
+void displayBid(const Bid& bid) {
+    cout << bid.bidId << ": " << bid.title << " | " << bid.amount << " | "
+            << bid.fund << endl;
+    return;
+}
+
+/**
+ * Load a CSV file containing bids into a container
+ *
+ * @param csvPath the path to the CSV file to load
+ * @param filter filter over loaded ids; every id read is added to it
+ * @return a container holding all the bids read
+ */
+void loadBids(string csvPath, HashTable* hashTable, BidBloomFilter* filter) {
+    cout << "Loading CSV file " << csvPath << endl;
+
+    // initialize the CSV Parser using the given path
+    csv::Parser file = csv::Parser(csvPath);
+
+    // read and display header row - optional
+    vector<string> header = file.getHeader();
+    for (auto const& c : header) {
+        cout << c << " | ";
+    }
+    cout << "" << endl;
+
+    // size the filter for the rows about to be loaded
+    filter->Reserve(file.rowCount());
+
+    try {
+
+        vector<Bid> bids;
+        bids.reserve(file.rowCount());
+
+        // loop to read rows of a CSV file
+        for (unsigned int i = 0; i < file.rowCount(); i++) {
+
+            // Create a data structure and add to the collection of bids
+            Bid bid;
+            bid.bidId = file[i][1];
+            bid.title = file[i][0];
+            bid.fund = file[i][8];
+            bid.amount = strToDouble(file[i][4], '$');
+
+            filter->Add(bid.bidId);
+            bids.push_back(bid);
+        }
+
+        // build the table in parallel; rows with an id that is already
+        // loaded are skipped, so the first copy of an id wins
+        size_t count = hashTable->BulkInsert(bids);
+
+        cout << count << " records read\n";
+        cout << hashTable->BucketCount() << " buckets, load factor "
+            << hashTable->LoadFactor() << "\n\n";
+
+    } catch (csv::Error &e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+/**
+ * Read every row of a CSV file into a vector of bids without
+ * printing or inserting them
+ *
+ * @param csvPath the path to the CSV file to load
+ * @return the bids in file order
+ */
+vector<Bid> readBids(string csvPath) {
+
+    vector<Bid> bids;
+    csv::Parser file = csv::Parser(csvPath);
+
+    try {
+        bids.reserve(file.rowCount());
+        for (unsigned int i = 0; i < file.rowCount(); i++) {
+            Bid bid;
+            bid.bidId = file[i][1];
+            bid.title = file[i][0];
+            bid.fund = file[i][8];
+            bid.amount = strToDouble(file[i][4], '$');
+            bids.push_back(bid);
+        }
+    } catch (csv::Error &e) {
+        std::cerr << e.what() << std::endl;
+    }
+
+    return bids;
+}
+
+/**
+ * Time lookups of every bid (hits) and of ids that are not present
+ * (misses) in a table
+ */
+template <typename Table>
+void timeLookups(const char* name, Table& table, const vector<Bid>& bids) {
+
+    clock_t ticks = clock();
+    size_t found = 0;
+    for (const Bid& bid : bids) {
+        found += !table.Search(bid.bidId).bidId.empty();
+    }
+    ticks = clock() - ticks;
+    cout << name << " hits: " << found << " | time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+
+    ticks = clock();
+    found = 0;
+    for (const Bid& bid : bids) {
+        found += !table.Search(bid.bidId + "0").bidId.empty();
+    }
+    ticks = clock() - ticks;
+    cout << name << " misses: " << bids.size() - found << " | time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+}
+
+/**
+ * Load the CSV file into the chained table and the open-addressing
+ * table and compare lookup times
+ *
+ * @param csvPath the path to the CSV file to load
+ */
+void compareHashTables(string csvPath) {
+
+    vector<Bid> bids = readBids(csvPath);
+
+    HashTable chained;
+    FlatHashTable flat;
+    for (const Bid& bid : bids) {
+        chained.Insert(bid);
+        flat.Insert(bid);
+    }
+
+    cout << "\n" << bids.size() << " bids loaded into each table\n";
+    timeLookups("chained", chained, bids);
+    timeLookups("open addressing", flat, bids);
+}
+
+/**
+ * Load the CSV file into two chained tables of the same size, one per
+ * hash mode, and report how evenly each spreads the bids
+ *
+ * @param csvPath the path to the CSV file to load
+ */
+void compareHashDistribution(string csvPath) {
+
+    vector<Bid> bids = readBids(csvPath);
+
+    const char* names[] = { "modulo", "string" };
+    HashTable::HashMode modes[] = { HashTable::HASH_MODULO, HashTable::HASH_STRING };
+
+    for (int i = 0; i < 2; ++i) {
+        HashTable table;
+        table.SetHashMode(modes[i]);
+        table.Reserve(bids.size());
+
+        clock_t ticks = clock();
+        for (const Bid& bid : bids) {
+            table.Insert(bid);
+        }
+        ticks = clock() - ticks;
+
+        cout << "\n" << names[i] << " hash, insert time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds\n";
+        table.PrintStats();
+    }
+}
+
+/**
+ * Freeze the loaded bids into a perfect hash index and compare lookup
+ * times against the chained table
+ *
+ * @param table the table holding the loaded bids
+ */
+void freezeAndCompare(HashTable& table) {
+
+    PerfectHashIndex index;
+
+    clock_t ticks = clock();
+    bool built = index.Freeze(table);
+    ticks = clock() - ticks;
+
+    if (!built) {
+        cout << "\nCould not build a perfect hash over the loaded bids; an id may be loaded twice\n";
+        return;
+    }
+
+    cout << "\n" << index.Size() << " bids frozen | " << index.BitsPerKey() << " bits per key | build time: "
+        << ticks * 1.0 / CLOCKS_PER_SEC << " seconds\n";
+
+    vector<Bid> bids;
+    HashTable::Cursor cursor = table.Begin();
+    table.Fetch(cursor, table.Size(), bids);
+
+    timeLookups("chained", table, bids);
+    timeLookups("perfect hash", index, bids);
+}
+
+/**
+ * Returns the given percentile of a sorted list of latencies
+ */
+long long percentile(const vector<long long>& sorted, double fraction) {
+    size_t index = (size_t)(fraction * (sorted.size() - 1));
+    return sorted[index];
+}
+
+/**
+ * Insert a run of bids into an empty table one at a time, timing each
+ * insert, and report the latency distribution. Growth happens several
+ * times during the run, so the tail shows the cost of rehashing.
+ *
+ * @param incremental true to spread each rehash over later operations
+ */
+void timeInsertLatency(bool incremental) {
+
+    // number of bids inserted into the table
+    const int bidCount = 500000;
+
+    HashTable table;
+    table.SetIncrementalRehash(incremental);
+
+    vector<long long> latencies;
+    latencies.reserve(bidCount);
+
+    Bid bid;
+    for (int i = 0; i < bidCount; ++i) {
+        bid.bidId = to_string(i);
+
+        // wall time per call; clock() is too coarse for a single insert
+        auto start = chrono::steady_clock::now();
+        table.Insert(bid);
+        auto stop = chrono::steady_clock::now();
+
+        latencies.push_back(chrono::duration_cast<chrono::nanoseconds>(stop - start).count());
+    }
+
+    sort(latencies.begin(), latencies.end());
+
+    cout << (incremental ? "incremental" : "stop-the-world") << " rehash, "
+        << bidCount << " inserts (nanoseconds)\n";
+    cout << "  p50: " << percentile(latencies, 0.50)
+        << " | p99: " << percentile(latencies, 0.99)
+        << " | p99.9: " << percentile(latencies, 0.999)
+        << " | max: " << latencies.back() << endl;
 }
 
 /**
- * Remove a bid
- *
- * @param bidId The bid id to search for
+ * Compare insert tail latency with and without incremental rehashing
  */
-void HashTable::Remove(string bidId) {
+void benchmarkRehashLatency() {
+    cout << "\n";
+    timeInsertLatency(false);
+    timeInsertLatency(true);
+}
 
-    // create a variable to store the hash of the bidid
-    unsigned bidIdKey = this->hash(std::atoi(bidId.c_str()));
+/**
+ * Compare a loop over Search against SearchBatch on a table too large
+ * for the cache, looking the ids up in random order
+ */
+void benchmarkBatchSearch() {
 
-    // get the index where the bid is located
-    Node* index = &nodes.at(bidIdKey);
+    // number of bids in the table
+    const int bidCount = 1000000;
 
-    // if there is only a node here, then erase it
-    if (index->next == nullptr) {
+    HashTable table;
+    table.SetHashMode(HashTable::HASH_STRING);
+    table.Reserve(bidCount);
 
-        std::cout << "\n\n\t[[ " << bidId << " deleted ]]\n\n";
+    vector<string> bidIds;
+    bidIds.reserve(bidCount);
 
-        nodes.erase(nodes.begin() + bidIdKey);
-        index->key = UINT_MAX;
-        return;
+    Bid bid;
+    for (int i = 0; i < bidCount; ++i) {
+        bid.bidId = to_string(i);
+        table.Insert(bid);
+        bidIds.push_back(bid.bidId);
     }
 
-   
-    // if index is the head node, we need to move the chain to the index node
-    if (index->bid.bidId == bidId) {
+    // random order so consecutive lookups hit unrelated buckets
+    shuffle(bidIds.begin(), bidIds.end(), default_random_engine(42));
 
-        // create pointer to the next node
-        Node* temp = index->next;
-        
-        // assign that node to be at that bucket
-        nodes.at(bidIdKey) = *temp;
+    clock_t ticks = clock();
+    size_t found = 0;
+    for (const string& bidId : bidIds) {
+        found += !table.Search(bidId).bidId.empty();
+    }
+    ticks = clock() - ticks;
+    cout << "\none at a time, hits: " << found << " | time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+
+    vector<Bid> results;
+    ticks = clock();
+    found = table.SearchBatch(bidIds, results);
+    ticks = clock() - ticks;
+    cout << "batched, hits: " << found << " | time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+}
 
-        std::cout << "\n\n\t[[ " << bidId << " deleted ]]\n\n";
+/**
+ * Run a mixed workload (90% search, 5% insert, 5% remove) against a
+ * sharded table from several threads for a fixed wall-clock time.
+ *
+ * @param table the table to stress
+ * @param threadCount number of worker threads
+ * @param keyCount size of the bid id key space
+ * @return operations completed per second
+ */
+double stressShardedTable(ShardedHashTable& table, int threadCount, int keyCount) {
+
+    // wall time is used since clock() adds up the cpu time of every thread
+    const auto duration = chrono::milliseconds(250);
+    atomic<bool> stop{false};
+    atomic<long long> totalOps{0};
+    vector<thread> workers;
+
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&, t]() {
+            mt19937 rng(t + 1);
+            long long ops = 0;
+            Bid bid;
 
-        // now delete the node
-        delete temp;
+            while (!stop.load(memory_order_relaxed)) {
+                bid.bidId = to_string(rng() % keyCount);
+                unsigned op = rng() % 20;
+
+                // inserts only add ids that are missing, so the table
+                // stays about half full and never holds duplicates
+                if (op == 0) {
+                    table.InsertIfAbsent(bid);
+                }
+                else if (op == 1) {
+                    table.Remove(bid.bidId);
+                }
+                else {
+                    table.Search(bid.bidId);
+                }
+                ++ops;
+            }
+            totalOps.fetch_add(ops);
+        });
+    }
 
-        return;
+    this_thread::sleep_for(duration);
+    stop.store(true);
+    for (thread& worker : workers) {
+        worker.join();
     }
 
-    // if there are multiple bids at this bucket, then remove the correct one
-    Node* curr = index->next;
+    return totalOps.load() / chrono::duration<double>(duration).count();
+}
 
-    // walk the list until we find the correct bid
-    while (curr != nullptr) {
-        if (bidId == curr->bid.bidId) {
+/**
+ * Compare throughput of the sharded table against the same table with
+ * a single lock at increasing thread counts.
+ */
+void benchmarkShardedTable() {
 
-            // if we found it, then set it to a temp variable and re-assign the pointer
-            Node* temp = curr;
-            index->next = temp->next;
-            
-            cout << "\n\n\t[[ " << bidId << " deleted ]]\n\n";
+    // bid id key space; half of it is loaded before timing starts
+    const int keyCount = 200000;
 
-            // now delete it
-            delete temp;
-            temp = nullptr;
+    // the same thread counts as the lock-free benchmarks, which are
+    // limited by the reclaimer's participant slots
+    int maxThreads = min<int>(max(4u, thread::hardware_concurrency()), EPOCH_MAX_THREADS);
 
-            return;
-        }
-        else {
-            index = index->next;
-            curr = curr->next;
+    cout << "\nthreads | 64 shards ops/sec | 1 lock ops/sec\n";
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        ShardedHashTable sharded(64);
+        ShardedHashTable locked(1);
+
+        for (int i = 0; i < keyCount; i += 2) {
+            Bid bid;
+            bid.bidId = to_string(i);
+            sharded.Insert(bid);
+            locked.Insert(bid);
         }
-    }
 
+        double shardedOps = stressShardedTable(sharded, threads, keyCount);
+        double lockedOps = stressShardedTable(locked, threads, keyCount);
+
+        cout << threads << " | " << (long long)shardedOps
+            << " | " << (long long)lockedOps << endl;
+    }
 }
 
 /**
- * Search for the specified bidId
+ * Search a table from several reader threads while one writer thread
+ * keeps inserting and removing bids, for a fixed wall-clock time.
+ * Even ids are loaded beforehand; the writer only touches odd ids.
  *
- * @param bidId The bid id to search for
+ * @param table the table to read from
+ * @param readerCount number of reader threads
+ * @param keyCount size of the bid id key space
+ * @return searches completed per second
  */
-Bid HashTable::Search(string bidId) {
-    Bid bid;
-
-    // hash the incoming bidId we are searching for
-    unsigned bidIdKey = this->hash(std::atoi(bidId.c_str()));
-
-    // create pointer to the index that matches the bid key
-    Node* temp = &(nodes.at(bidIdKey));
-
-    // if the node exists and matches the key, then return the bid that was found
-    if (temp != nullptr && temp->key != UINT_MAX && temp->bid.bidId == bidId) {
-        return temp->bid;
+template <typename Table>
+double measureReadThroughput(Table& table, int readerCount, int keyCount) {
+
+    // wall time is used since clock() adds up the cpu time of every thread
+    const auto duration = chrono::milliseconds(250);
+    atomic<bool> stop{false};
+    atomic<long long> totalReads{0};
+    vector<thread> workers;
+
+    for (int t = 0; t < readerCount; ++t) {
+        workers.emplace_back([&, t]() {
+            mt19937 rng(t + 1);
+            long long reads = 0;
+
+            while (!stop.load(memory_order_relaxed)) {
+                table.Search(to_string(rng() % keyCount));
+                ++reads;
+            }
+            totalReads.fetch_add(reads);
+        });
     }
 
-    // if there is no entry for the key, then return the dummy bid
-    if (temp == nullptr || temp->key == UINT_MAX) {
-        return bid;
-    }
+    workers.emplace_back([&]() {
+        mt19937 rng(0);
+        Bid bid;
 
-    // walk the sublists looking for the bidId we are searching for
-    // if we find it, then return the respective bid
-    while (temp != nullptr) {
-        if (temp->key != UINT_MAX && temp->bid.bidId == bidId) {
-            return temp->bid;
+        while (!stop.load(memory_order_relaxed)) {
+            bid.bidId = to_string((rng() % keyCount) | 1);
+            table.Insert(bid);
+            table.Remove(bid.bidId);
         }
+    });
 
-        temp = temp->next;
+    this_thread::sleep_for(duration);
+    stop.store(true);
+    for (thread& worker : workers) {
+        worker.join();
     }
 
-    // if we walk the whole list and don't find the bid, then return the dummy bid
-    return bid;
-
+    return totalReads.load() / chrono::duration<double>(duration).count();
 }
 
-//============================================================================
-// Static methods used for testing
-//============================================================================
+/**
+ * Compare search throughput of the lock-free read table against the
+ * sharded table at increasing reader counts, with one writer running.
+ */
+void benchmarkLockFreeReads() {
 
+    // bid id key space; the even half is loaded before timing starts
+    const int keyCount = 200000;
 
-Bid getBid() {
-    Bid bid;
+    // the readers, the writer and this thread each need an epoch slot
+    int maxThreads = min<int>(max(4u, thread::hardware_concurrency()), EPOCH_MAX_THREADS - 2);
 
-    cout << "Enter Id: ";
-    cin.ignore();
-    getline(cin, bid.bidId);
+    cout << "\nreaders | lock-free reads/sec | sharded reads/sec\n";
 
-    cout << "Enter title: ";
-    getline(cin, bid.title);
+    for (int readers = 1; readers <= maxThreads; readers *= 2) {
+        ConcurrentHashTable lockFree;
+        ShardedHashTable sharded;
 
-    cout << "Enter fund: ";
-    getline(cin, bid.fund);
+        for (int i = 0; i < keyCount; i += 2) {
+            Bid bid;
+            bid.bidId = to_string(i);
+            lockFree.Insert(bid);
+            sharded.Insert(bid);
+        }
 
-    cout << "Enter amount: ";
-    cin.clear();
-    cin.ignore();
-    string strAmount;
-    getline(cin, strAmount);
-    bid.amount = strToDouble(strAmount, '$');
+        double lockFreeReads = measureReadThroughput(lockFree, readers, keyCount);
+        double shardedReads = measureReadThroughput(sharded, readers, keyCount);
 
-    return bid;
+        cout << readers << " | " << (long long)lockFreeReads
+            << " | " << (long long)shardedReads << endl;
+    }
 }
 
-
-
 /**
- * Display the bid information to the console (std::out)
- *
- * @param bid struct containing the bid info
+ * Compare building a large table with one Insert per bid against
+ * BulkInsert
  */
-void displayBid(Bid bid) {
-    cout << bid.bidId << ": " << bid.title << " | " << bid.amount << " | "
-            << bid.fund << endl;
-    return;
+void benchmarkBulkBuild() {
+
+    // number of bids in the table
+    const int bidCount = 2000000;
+
+    vector<Bid> bids(bidCount);
+    for (int i = 0; i < bidCount; ++i) {
+        bids[i].bidId = to_string(i);
+    }
+
+    // wall time is used since clock() adds up the cpu time of every thread
+    {
+        HashTable table;
+        table.SetHashMode(HashTable::HASH_STRING);
+
+        auto start = chrono::steady_clock::now();
+        for (const Bid& bid : bids) {
+            table.Insert(bid);
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        cout << "\none insert at a time, " << table.Size() << " bids | time: " << elapsed.count() << " seconds" << endl;
+    }
+
+    {
+        HashTable table;
+        table.SetHashMode(HashTable::HASH_STRING);
+
+        auto start = chrono::steady_clock::now();
+        table.BulkInsert(bids);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        cout << "bulk build, " << table.Size() << " bids | time: " << elapsed.count() << " seconds" << endl;
+    }
 }
 
 /**
- * Load a CSV file containing bids into a container
+ * Time every search of a table one at a time and print the latency
+ * percentiles
  *
- * @param csvPath the path to the CSV file to load
- * @return a container holding all the bids read
+ * @param name label for the table
+ * @param table the table to search
+ * @param bidIds the ids to look up, in lookup order
  */
-void loadBids(string csvPath, HashTable* hashTable) {
-    cout << "Loading CSV file " << csvPath << endl;
+template <typename Table>
+void timeSearchLatency(const char* name, Table& table, const vector<string>& bidIds) {
 
-    // initialize the CSV Parser using the given path
-    csv::Parser file = csv::Parser(csvPath);
+    vector<long long> latencies;
+    latencies.reserve(bidIds.size());
 
-    // read and display header row - optional
-    vector<string> header = file.getHeader();
-    for (auto const& c : header) {
-        cout << c << " | ";
-    }
-    cout << "" << endl;
+    for (const string& bidId : bidIds) {
 
-    try {
+        // wall time per call; clock() is too coarse for a single search
+        auto start = chrono::steady_clock::now();
+        table.Search(bidId);
+        auto stop = chrono::steady_clock::now();
 
-        // create a count variable
-        int count = 0;
+        latencies.push_back(chrono::duration_cast<chrono::nanoseconds>(stop - start).count());
+    }
 
-        // loop to read rows of a CSV file
-        for (unsigned int i = 0; i < file.rowCount(); i++) {
+    sort(latencies.begin(), latencies.end());
 
-            // Create a data structure and add to the collection of bids
-            Bid bid;
-            bid.bidId = file[i][1];
-            bid.title = file[i][0];
-            bid.fund = file[i][8];
-            bid.amount = strToDouble(file[i][4], '$');
+    cout << name << ", " << bidIds.size() << " searches (nanoseconds)\n";
+    cout << "  p50: " << percentile(latencies, 0.50)
+        << " | p99: " << percentile(latencies, 0.99)
+        << " | p99.9: " << percentile(latencies, 0.999)
+        << " | max: " << latencies.back() << endl;
+}
 
-            // display the bid and increment the count
-            displayBid(bid);
-            count++;
+/**
+ * Compare search tail latency of the chained table and the cuckoo table.
+ * Half the lookups hit and half miss, in random order.
+ */
+void benchmarkCuckooLatency() {
 
-            // Insert bid to hash table
-            hashTable->Insert(bid);
+    // number of bids in each table
+    const int bidCount = 1000000;
 
-        }
+    HashTable chained;
+    chained.SetHashMode(HashTable::HASH_STRING);
+    CuckooHashTable cuckoo;
 
-        cout << count << " records read\n\n";
+    vector<Bid> bids(bidCount);
+    for (int i = 0; i < bidCount; ++i) {
+        bids[i].bidId = to_string(i * 2);
+        cuckoo.Insert(bids[i]);
+    }
+    chained.BulkInsert(bids);
 
-    } catch (csv::Error &e) {
-        std::cerr << e.what() << std::endl;
+    vector<string> bidIds;
+    bidIds.reserve(bidCount);
+    for (int i = 0; i < bidCount; ++i) {
+        bidIds.push_back(to_string(i));
     }
+    shuffle(bidIds.begin(), bidIds.end(), default_random_engine(42));
+
+    cout << "\n";
+    timeSearchLatency("chained", chained, bidIds);
+    timeSearchLatency("cuckoo", cuckoo, bidIds);
 }
 
 /**
@@ -444,13 +3717,34 @@ int main(int argc, char* argv[]) {
     // Define a hash table to hold all the bids
     HashTable* bidTable;
 
-    // create temp bids used in the menu loop
+    // create a temp bid used in the menu loop
     Bid bid;
-    Bid searchBid;
+
+    // a stored bid returned by Find; nothing is copied to show it
+    const Bid* found = nullptr;
 
     string input;
     bidTable = new HashTable();
 
+    // spread rehashing over later operations so no single call stalls
+    bidTable->SetIncrementalRehash(true);
+
+    // hash the id's characters so any id is accepted
+    bidTable->SetHashMode(HashTable::HASH_STRING);
+
+    // filter over loaded ids for fast duplicate checks
+    BidBloomFilter bidFilter;
+
+    // paging position kept between menu actions, so the next page
+    // carries on from the cursor instead of walking from the first bucket
+    const size_t pageSize = 20;
+    HashTable::Cursor pageCursor = bidTable->Begin();
+    int pageNumber = 0;
+
+    // on-disk copy of the table, saved and opened from the menu
+    MappedBidIndex bidIndex;
+    string indexPath = csvPath + ".idx";
+
     // print the main menu and get user input
     int choice = 0;
     while (choice != 9) {
@@ -460,6 +3754,21 @@ int main(int argc, char* argv[]) {
         cout << "  3. Search Bid" << endl;
         cout << "  4. Add bid" << endl;
         cout << "  5. Remove Bid" << endl;
+        cout << "  6. Display a Page of Bids" << endl;
+        cout << "  7. Compare Hash Tables" << endl;
+        cout << "  8. Rehash Latency Benchmark" << endl;
+        cout << " 10. Compare Hash Distribution" << endl;
+        cout << " 11. Batch Search Benchmark" << endl;
+        cout << " 12. Concurrent Table Benchmark" << endl;
+        cout << " 13. Lock-free Read Benchmark" << endl;
+        cout << " 14. Bulk Build Benchmark" << endl;
+        cout << " 15. Freeze Bids into a Perfect Hash" << endl;
+        cout << " 16. Cuckoo Search Latency Benchmark" << endl;
+        cout << " 17. Save Bid Index to Disk" << endl;
+        cout << " 18. Open Bid Index and Search" << endl;
+        cout << " 19. Display Table Statistics" << endl;
+        cout << " 20. Query Bids by Fund" << endl;
+        cout << " 21. Display the Next Page of Bids" << endl;
         cout << "  9. Exit" << endl;
         cout << "Enter choice: ";
         cin >> choice;
@@ -473,7 +3782,7 @@ int main(int argc, char* argv[]) {
             ticks = clock();
 
             // Complete the method call to load the bids
-            loadBids(csvPath, bidTable);
+            loadBids(csvPath, bidTable, &bidFilter);
 
             // Calculate elapsed time and display result
             ticks = clock() - ticks; // current clock ticks minus starting clock ticks
@@ -505,14 +3814,14 @@ int main(int argc, char* argv[]) {
             getline(cin, input);
             ticks = clock();
 
-            bid = bidTable->Search(input);
+            found = bidTable->Find(input);
 
 
             ticks = clock() - ticks; // current clock ticks minus starting clock ticks
 
-            if (!bid.bidId.empty()) {
+            if (found != nullptr) {
                 cout << "\n";
-                displayBid(bid);
+                displayBid(*found);
                 cout << "\n";
             } else {
                 cout << "\nBid Id " << input << " not found.\n" << endl;
@@ -529,9 +3838,9 @@ int main(int argc, char* argv[]) {
             // get bid info from user input
             bid = getBid();
 
-            // search to make sure the bid does not already exist
-            searchBid = bidTable->Search(bid.bidId);
-            if (!searchBid.bidId.empty()) {
+            // search to make sure the bid does not already exist;
+            // the filter answers "definitely new" without a search
+            if (bidFilter.MightContain(bid.bidId) && bidTable->Find(bid.bidId) != nullptr) {
                 cout << "\n\nCannot enter a duplicate bid id\n\n";
                 break;
             }
@@ -540,10 +3849,10 @@ int main(int argc, char* argv[]) {
             if (!bid.bidId.empty()) {
 
                 bidTable->Insert(bid);
+                bidFilter.Add(bid.bidId);
 
-                Bid temp = bidTable->Search(bid.bidId);
                 cout << "\n\nBid inserted:\n";
-                displayBid(temp);
+                displayBid(*bidTable->Find(bid.bidId));
                 cout << "\n";
             }
 
@@ -559,17 +3868,226 @@ int main(int argc, char* argv[]) {
             cin.ignore();
             getline(cin, input);
 
-            // search to see if the bidid exists
-            bid = bidTable->Search(input);
-
-            // if it exists, then remove it
-            if (!bid.bidId.empty()) {
+            // search to see if the bidid exists, and if it does, remove it
+            if (bidTable->Find(input) != nullptr) {
                 bidTable->Remove(input);
             }
             else {
                 cout << "\nBid id " << input << " not found." << endl;
             }
 
+            break;
+
+        // display one page of bids using a table cursor
+        case 6:
+
+            cout << "\nEnter the page number: ";
+            cin >> input;
+
+            {
+                int page = max(1, atoi(input.c_str()));
+                vector<Bid> rows;
+
+                ticks = clock();
+
+                pageCursor = bidTable->Seek((page - 1) * pageSize);
+                bidTable->Fetch(pageCursor, pageSize, rows);
+                pageNumber = page;
+
+                ticks = clock() - ticks; // current clock ticks minus starting clock ticks
+
+                cout << "\nPage " << page << ":\n";
+                for (const Bid& row : rows) {
+                    displayBid(row);
+                }
+                cout << "time: " << ticks << " clock ticks" << endl;
+                cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+            }
+
+            break;
+
+        // compare the chained table against the open-addressing table
+        case 7:
+
+            compareHashTables(csvPath);
+
+            break;
+
+        // compare insert latency with and without incremental rehashing
+        case 8:
+
+            benchmarkRehashLatency();
+
+            break;
+
+        // compare chain lengths under the modulo and string hashes
+        case 10:
+
+            compareHashDistribution(csvPath);
+
+            break;
+
+        // compare single lookups against prefetching batched lookups
+        case 11:
+
+            benchmarkBatchSearch();
+
+            break;
+
+        // compare the sharded table against a single lock across threads
+        case 12:
+
+            benchmarkShardedTable();
+
+            break;
+
+        // compare lock-free searches against shard locks under a writer
+        case 13:
+
+            benchmarkLockFreeReads();
+
+            break;
+
+        // compare serial inserts against the parallel bulk build
+        case 14:
+
+            benchmarkBulkBuild();
+
+            break;
+
+        // build a perfect hash over the loaded bids and compare lookups
+        case 15:
+
+            freezeAndCompare(*bidTable);
+
+            break;
+
+        // compare search tail latency of chained and cuckoo tables
+        case 16:
+
+            benchmarkCuckooLatency();
+
+            break;
+
+        // write the loaded bids to an index file
+        case 17:
+
+            // unmap the old index first; a mapped file can't be replaced on Windows
+            bidIndex.Close();
+
+            ticks = clock();
+
+            if (MappedBidIndex::Save(*bidTable, indexPath)) {
+                cout << "\n" << bidTable->Size() << " bids saved to " << indexPath << endl;
+            }
+            else {
+                cout << "\nCould not write " << indexPath << endl;
+            }
+
+            ticks = clock() - ticks; // current clock ticks minus starting clock ticks
+            cout << "time: " << ticks << " clock ticks" << endl;
+            cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+
+            break;
+
+        // map the index file and search it without loading the CSV
+        case 18:
+
+            ticks = clock();
+
+            if (!bidIndex.Open(indexPath)) {
+                cout << "\nCould not open " << indexPath << "; save the index first" << endl;
+                break;
+            }
+
+            ticks = clock() - ticks; // current clock ticks minus starting clock ticks
+            cout << "\n" << bidIndex.Size() << " bids mapped from " << indexPath << endl;
+            cout << "open time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+
+            cout << "\nEnter the bid id: ";
+            cin.ignore();
+            getline(cin, input);
+            ticks = clock();
+
+            bid = bidIndex.Search(input);
+
+            ticks = clock() - ticks; // current clock ticks minus starting clock ticks
+
+            if (!bid.bidId.empty()) {
+                cout << "\n";
+                displayBid(bid);
+                cout << "\n";
+            } else {
+                cout << "\nBid Id " << input << " not found.\n" << endl;
+            }
+
+            cout << "time: " << ticks << " clock ticks" << endl;
+            cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+            break;
+
+        // report the health of the loaded table
+        case 19:
+
+            cout << "\n";
+            bidTable->PrintStats();
+
+            break;
+
+        // list, count and total the bids of one fund
+        case 20:
+
+            cout << "\nEnter the fund: ";
+            cin.ignore();
+            getline(cin, input);
+
+            {
+                vector<const Bid*> rows;
+
+                ticks = clock();
+
+                bidTable->FindByFund(input, rows);
+                unsigned int count = bidTable->CountByFund(input);
+                double total = bidTable->SumByFund(input);
+
+                ticks = clock() - ticks; // current clock ticks minus starting clock ticks
+
+                cout << "\n";
+                for (const Bid* row : rows) {
+                    displayBid(*row);
+                }
+                cout << "\n" << input << ": " << count << " bids | total amount: " << total << endl;
+                cout << "time: " << ticks << " clock ticks" << endl;
+                cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+            }
+
+            break;
+
+        // display the page after the last one shown, resuming from the saved cursor
+        case 21:
+
+            {
+                vector<Bid> rows;
+
+                ticks = clock();
+
+                bidTable->Fetch(pageCursor, pageSize, rows);
+
+                ticks = clock() - ticks; // current clock ticks minus starting clock ticks
+
+                if (rows.empty()) {
+                    cout << "\nNo more bids." << endl;
+                    break;
+                }
+                pageNumber += 1;
+
+                cout << "\nPage " << pageNumber << ":\n";
+                for (const Bid& row : rows) {
+                    displayBid(row);
+                }
+                cout << "time: " << ticks << " clock ticks" << endl;
+                cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+            }
+
             break;
         }
     }
@@ -6,9 +6,15 @@
 // Description : Hello World in C++, Ansi-style
 //============================================================================
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <random>
+#include <string>
 #include <time.h>
+#include <vector>
 
+#include "BidBloomFilter.hpp"
 #include "CSVparser.hpp"
 
 using namespace std;
@@ -37,10 +43,14 @@ struct Node {
     Node *left;
     Node *right;
 
+    // height of the subtree rooted here, a leaf is 1 (balanced mode only)
+    int height;
+
     // default constructor
     Node() {
         left = nullptr;
         right = nullptr;
+        height = 1;
     }
 
     // initialize with a bid
@@ -66,9 +76,24 @@ class BinarySearchTree {
 private:
     Node* root;
 
+    // number of bids in the tree
+    size_t size;
+
+    // keep the tree height balanced (AVL) on insert and remove
+    bool balanced;
+
     // function to add a node
     void addNode(Node* node, Bid bid);
 
+    // AVL helper functions used in balanced mode
+    static int heightOf(Node* node);
+    static void updateHeight(Node* node);
+    static Node* rotateLeft(Node* node);
+    static Node* rotateRight(Node* node);
+    static Node* rebalance(Node* node);
+    Node* insertBalanced(Node* node, Bid bid);
+    Node* removeBalanced(Node* node, string bidId, bool& removed);
+
     // traversal functions
     void inOrder(Node* node);
     void postOrder(Node* node);
@@ -86,15 +111,12 @@ private:
     // helper function for searching
     Node* SearchHelperA(Node* node, string bidId);
 
-    // function to get size of tree
-    size_t sizeHelper(Node* node);
-
 
 
 public:
 
     // constructor
-    BinarySearchTree();
+    explicit BinarySearchTree(bool balanced = false);
 
     // destructor
     virtual ~BinarySearchTree();
@@ -122,16 +144,48 @@ public:
     // function to get the size of the tree
     size_t GetSize();
 
+    // function to get the number of levels in the tree
+    int GetHeight();
+
+    /// <summary>
+    /// Resumable in-order position in the tree used for paging.
+    /// Holds the ancestors still to be visited, so advancing is
+    /// amortized constant time. Inserting or removing bids
+    /// invalidates the cursor.
+    /// </summary>
+    class Cursor {
+        friend class BinarySearchTree;
+        vector<Node*> path;
+    public:
+        bool AtEnd() const { return path.empty(); }
+    };
+
+    // cursor functions for paging through the tree without printing
+    Cursor Begin();
+    Cursor Seek(size_t position);
+    Cursor SeekKey(string bidId);
+    size_t Fetch(Cursor& cursor, size_t count, vector<Bid>& rows);
+
+private:
+
+    // helper function to push a node and its left spine onto a cursor
+    void pushLeftSpine(Cursor& cursor, Node* node);
+
 };
 
 
 /**
  * Default constructor
+ *
+ * @param balanced rebalance on every insert and remove so the height
+ *                 stays O(log n) even when bids arrive sorted by id
  */
-BinarySearchTree::BinarySearchTree() {
+BinarySearchTree::BinarySearchTree(bool balanced) {
 
     // set root to nullptr
     root = nullptr;
+    size = 0;
+    this->balanced = balanced;
 }
 
 /**
@@ -163,21 +217,40 @@ void BinarySearchTree::ClearTree(Node* node) {
 }
 
 
-// function to get size of tree (calls the sizehelper function)
+// function to get size of tree (kept as a running count)
 size_t BinarySearchTree::GetSize() {
-    return sizeHelper(root);
+    return size;
 }
 
-// recursive function to get the size of the tree
-size_t BinarySearchTree::sizeHelper(Node* node) {
+/// <summary>
+/// Function to get the number of levels in the tree. It walks one level
+/// at a time, so an unbalanced tree can't overflow the stack.
+/// </summary>
+/// <returns></returns>
+int BinarySearchTree::GetHeight() {
 
-    // if the root is null, then the tree size is 0
-    if (node == nullptr) {
-        return 0;
+    int height = 0;
+    vector<Node*> level;
+    if (root != nullptr) {
+        level.push_back(root);
     }
 
-    // recursively call helper function on the left and right side
-    return 1 + sizeHelper(node->left) + sizeHelper(node->right);
+    while (!level.empty()) {
+        height += 1;
+
+        vector<Node*> below;
+        for (Node* node : level) {
+            if (node->left != nullptr) {
+                below.push_back(node->left);
+            }
+            if (node->right != nullptr) {
+                below.push_back(node->right);
+            }
+        }
+        level.swap(below);
+    }
+
+    return height;
 }
 
 /// <summary>
@@ -225,8 +298,15 @@ Node* BinarySearchTree::GetParentHelper(Node* tree, Node* node) {
  */
 void BinarySearchTree::Insert(Bid bid) {
 
+    size += 1;
+
+    // in balanced mode the insert rebuilds the path back up to the root
+    if (balanced) {
+        root = insertBalanced(root, bid);
+    }
+
     // if the root is null, then this bid will be the root of the tree
-    if (root == nullptr) {
+    else if (root == nullptr) {
         Node* newNode = new Node(bid);
         root = newNode;
     }
@@ -278,6 +358,16 @@ void BinarySearchTree::addNode(Node* node, Bid bid) {
 /// <param name="bidId"></param>
 void BinarySearchTree::removeRecur(string bidId) {
 
+    // in balanced mode remove the bid and rebalance on the way back up
+    if (balanced) {
+        bool removed = false;
+        root = removeBalanced(root, bidId, removed);
+        if (removed) {
+            size -= 1;
+        }
+        return;
+    }
+
     // create pointer to the node we want to delete using search function
     Node* node = SearchA(bidId);
 
@@ -285,7 +375,9 @@ void BinarySearchTree::removeRecur(string bidId) {
     Node* parent = GetParent(node);
 
     // call remove helper function
-    removeNodeRecur(root, parent, node);
+    if (removeNodeRecur(root, parent, node)) {
+        size -= 1;
+    }
 }
 
 
@@ -333,6 +425,8 @@ bool BinarySearchTree::removeNodeRecur(Node* tree, Node* parent, Node* node) {
         // otherwise, the right node is the new root
         else
             root = node->right;
+
+        delete node;
     }
 
     // if only a left child
@@ -344,6 +438,8 @@ bool BinarySearchTree::removeNodeRecur(Node* tree, Node* parent, Node* node) {
         }
         else
             parent->right = node->left;
+
+        delete node;
     }
 
     // if the only a right child or a leaf
@@ -355,11 +451,154 @@ bool BinarySearchTree::removeNodeRecur(Node* tree, Node* parent, Node* node) {
         else {
             parent->right = node->right;
         }
+
+        delete node;
     }
 
     return true;
 }
 
+/// <summary>
+/// Height of a subtree, 0 for an empty one
+/// </summary>
+/// <param name="node"></param>
+/// <returns></returns>
+int BinarySearchTree::heightOf(Node* node) {
+    return node == nullptr ? 0 : node->height;
+}
+
+/// <summary>
+/// Recompute a node's height from its children
+/// </summary>
+/// <param name="node"></param>
+void BinarySearchTree::updateHeight(Node* node) {
+    node->height = 1 + max(heightOf(node->left), heightOf(node->right));
+}
+
+/// <summary>
+/// Rotate a subtree left; the right child becomes its root
+/// </summary>
+/// <param name="node"></param>
+/// <returns>the new root of the subtree</returns>
+Node* BinarySearchTree::rotateLeft(Node* node) {
+    Node* pivot = node->right;
+    node->right = pivot->left;
+    pivot->left = node;
+    updateHeight(node);
+    updateHeight(pivot);
+    return pivot;
+}
+
+/// <summary>
+/// Rotate a subtree right; the left child becomes its root
+/// </summary>
+/// <param name="node"></param>
+/// <returns>the new root of the subtree</returns>
+Node* BinarySearchTree::rotateRight(Node* node) {
+    Node* pivot = node->left;
+    node->left = pivot->right;
+    pivot->right = node;
+    updateHeight(node);
+    updateHeight(pivot);
+    return pivot;
+}
+
+/// <summary>
+/// Restore the AVL property at a node whose subtrees differ in height
+/// by at most two, using a single or double rotation
+/// </summary>
+/// <param name="node"></param>
+/// <returns>the new root of the subtree</returns>
+Node* BinarySearchTree::rebalance(Node* node) {
+
+    updateHeight(node);
+    int balance = heightOf(node->left) - heightOf(node->right);
+
+    // left heavy; a right-leaning left child needs a double rotation
+    if (balance > 1) {
+        if (heightOf(node->left->left) < heightOf(node->left->right)) {
+            node->left = rotateLeft(node->left);
+        }
+        return rotateRight(node);
+    }
+
+    // right heavy; a left-leaning right child needs a double rotation
+    if (balance < -1) {
+        if (heightOf(node->right->right) < heightOf(node->right->left)) {
+            node->right = rotateRight(node->right);
+        }
+        return rotateLeft(node);
+    }
+
+    return node;
+}
+
+/// <summary>
+/// Add a bid below a node and rebalance each node on the way back up.
+/// The recursion is only as deep as the tree, which stays O(log n).
+/// </summary>
+/// <param name="node"></param>
+/// <param name="bid"></param>
+/// <returns>the new root of the subtree</returns>
+Node* BinarySearchTree::insertBalanced(Node* node, Bid bid) {
+
+    if (node == nullptr) {
+        return new Node(bid);
+    }
+
+    // equal ids go right, the same as addNode
+    if (node->bid.bidId > bid.bidId) {
+        node->left = insertBalanced(node->left, bid);
+    }
+    else {
+        node->right = insertBalanced(node->right, bid);
+    }
+
+    return rebalance(node);
+}
+
+/// <summary>
+/// Remove a bid below a node and rebalance each node on the way back up
+/// </summary>
+/// <param name="node"></param>
+/// <param name="bidId"></param>
+/// <param name="removed">set to true if a bid was removed</param>
+/// <returns>the new root of the subtree</returns>
+Node* BinarySearchTree::removeBalanced(Node* node, string bidId, bool& removed) {
+
+    if (node == nullptr) {
+        return nullptr;
+    }
+
+    if (node->bid.bidId > bidId) {
+        node->left = removeBalanced(node->left, bidId, removed);
+    }
+    else if (node->bid.bidId < bidId) {
+        node->right = removeBalanced(node->right, bidId, removed);
+    }
+
+    // with two children, take over the successor's bid and remove the
+    // successor from the right subtree instead
+    else if (node->left != nullptr && node->right != nullptr) {
+        Node* succNode = node->right;
+        while (succNode->left != nullptr) {
+            succNode = succNode->left;
+        }
+        node->bid = succNode->bid;
+        node->right = removeBalanced(node->right, succNode->bid.bidId, removed);
+    }
+
+    // otherwise the only child, if any, takes the node's place
+    else {
+        Node* child = node->left != nullptr ? node->left : node->right;
+        delete node;
+        removed = true;
+        return child;
+    }
+
+    return rebalance(node);
+}
+
 /// <summary>
 /// Function to print a bid within the Tree class
 /// </summary>
@@ -505,6 +744,857 @@ void BinarySearchTree::preOrder(Node* node) {
 
 }
 
+/// <summary>
+/// Push a node and every left descendant onto the cursor path
+/// </summary>
+/// <param name="cursor"></param>
+/// <param name="node"></param>
+void BinarySearchTree::pushLeftSpine(Cursor& cursor, Node* node) {
+    while (node != nullptr) {
+        cursor.path.push_back(node);
+        node = node->left;
+    }
+}
+
+/// <summary>
+/// Returns a cursor at the smallest bid id in the tree
+/// </summary>
+/// <returns></returns>
+BinarySearchTree::Cursor BinarySearchTree::Begin() {
+    Cursor cursor;
+    pushLeftSpine(cursor, root);
+    return cursor;
+}
+
+/// <summary>
+/// Returns a cursor at the given in-order position. Nodes carry no
+/// subtree counts, so this steps past every earlier bid and costs
+/// O(position); to read page after page, keep the cursor and Fetch
+/// from it rather than seeking each page.
+/// </summary>
+/// <param name="position"></param>
+/// <returns></returns>
+BinarySearchTree::Cursor BinarySearchTree::Seek(size_t position) {
+
+    Cursor cursor = Begin();
+
+    // step past position bids without copying them
+    for (size_t i = 0; i < position && !cursor.path.empty(); ++i) {
+        Node* node = cursor.path.back();
+        cursor.path.pop_back();
+        pushLeftSpine(cursor, node->right);
+    }
+
+    return cursor;
+}
+
+/// <summary>
+/// Returns a cursor at the first bid whose id is not less than bidId.
+/// Takes one walk down the tree, so it is O(height).
+/// </summary>
+/// <param name="bidId"></param>
+/// <returns></returns>
+BinarySearchTree::Cursor BinarySearchTree::SeekKey(string bidId) {
+
+    Cursor cursor;
+    Node* node = root;
+
+    // keep every ancestor the walk turns left at; those are still to come
+    while (node != nullptr) {
+        if (node->bid.bidId < bidId) {
+            node = node->right;
+        }
+        else {
+            cursor.path.push_back(node);
+            node = node->left;
+        }
+    }
+
+    return cursor;
+}
+
+/// <summary>
+/// Copy up to count bids in order starting at the cursor and move the
+/// cursor past them, so the next call resumes where this one stopped
+/// </summary>
+/// <param name="cursor"></param>
+/// <param name="count"></param>
+/// <param name="rows"></param>
+/// <returns>number of bids appended to rows</returns>
+size_t BinarySearchTree::Fetch(Cursor& cursor, size_t count, vector<Bid>& rows) {
+
+    size_t fetched = 0;
+    while (!cursor.path.empty() && fetched < count) {
+        Node* node = cursor.path.back();
+        cursor.path.pop_back();
+
+        rows.push_back(node->bid);
+        ++fetched;
+
+        // the right subtree comes next in order
+        pushLeftSpine(cursor, node->right);
+    }
+
+    return fetched;
+}
+
+//============================================================================
+// B+ Tree class definition
+//============================================================================
+
+// keys a node holds before it splits; a node's key array takes four cache lines
+const int BPTREE_MAX_KEYS = 31;
+
+// keys every node except the root keeps after a remove
+const int BPTREE_MIN_KEYS = BPTREE_MAX_KEYS / 2;
+
+/**
+ * Define a class containing data members and methods to
+ * implement a cache-conscious B+ tree of bids
+ *
+ * Each node keeps its keys in one contiguous array of 64-bit prefixes.
+ * A prefix is the first eight bytes of the bid id packed big-endian, so
+ * comparing prefixes orders ids the same way comparing the strings does.
+ * A node is searched with a branchless binary search over the prefixes;
+ * the full ids are only compared when two ids share their first eight
+ * bytes. Bids live in the leaves, which are linked for in-order scans.
+ * With up to 32 children per node, tens of millions of bids fit in a
+ * tree five levels high where a balanced binary tree needs about 25.
+ */
+class BidBPlusTree {
+
+private:
+    // fields shared by leaf and inner nodes; one slot of spare room
+    // lets a node overflow by a key before it is split. The header sits
+    // in front of the keys so a search reads the count, the leaf flag
+    // and every live key from the node's first four cache lines
+    struct alignas(64) BNode {
+        int count;
+        bool leaf;
+        uint64_t keys[BPTREE_MAX_KEYS + 1];
+
+        explicit BNode(bool isLeaf) {
+            count = 0;
+            leaf = isLeaf;
+        }
+    };
+
+    // a leaf holds the bids, ordered by id, and links to the next leaf
+    struct Leaf : BNode {
+        Bid bids[BPTREE_MAX_KEYS + 1];
+        Leaf* next;
+
+        Leaf() : BNode(true) {
+            next = nullptr;
+        }
+    };
+
+    // an inner node holds separators; children[i] covers the ids from
+    // separator i - 1 up to, but not including, separator i
+    struct Inner : BNode {
+        string ids[BPTREE_MAX_KEYS + 1];
+        BNode* children[BPTREE_MAX_KEYS + 2];
+
+        Inner() : BNode(false) {
+        }
+    };
+
+    BNode* root;
+    size_t size;
+    int height;
+
+    // key helper functions
+    static uint64_t prefixOf(const string& bidId);
+    static int lowerBound(const uint64_t* keys, int count, uint64_t key);
+    static int upperBound(const uint64_t* keys, int count, uint64_t key);
+    static int leafSlot(const Leaf* leaf, uint64_t prefix, const string& bidId);
+    static int childSlot(const Inner* inner, uint64_t prefix, const string& bidId);
+
+    // helper functions to walk, grow and shrink the tree
+    Leaf* findLeaf(uint64_t prefix, const string& bidId);
+    Leaf* firstLeaf();
+    BNode* insertInto(BNode* node, const Bid& bid, uint64_t prefix, uint64_t& sepKey, string& sepId, bool& added);
+    bool removeFrom(BNode* node, uint64_t prefix, const string& bidId);
+    void fixUnderflow(Inner* parent, int index);
+    void mergeChildren(Inner* parent, int index);
+    static void deleteNode(BNode* node);
+    void clearTree(BNode* node);
+
+public:
+
+    // constructor
+    BidBPlusTree();
+
+    // destructor
+    virtual ~BidBPlusTree();
+
+    // print every bid in order by walking the leaves
+    void InOrder();
+
+    // insert a bid; a bid with the same id is replaced
+    void Insert(Bid bid);
+
+    // search for a bid
+    Bid* SearchA(string bidId);
+
+    // remove a bid
+    void removeRecur(string bidId);
+
+    // function to get the size of the tree
+    size_t GetSize();
+
+    // number of levels, a lone leaf is 1
+    int GetHeight();
+
+    /// <summary>
+    /// Position of a bid within a leaf, used for paging. Inserting or
+    /// removing bids invalidates the cursor.
+    /// </summary>
+    class Cursor {
+        friend class BidBPlusTree;
+        Leaf* leaf = nullptr;
+        int slot = 0;
+    public:
+        bool AtEnd() const { return leaf == nullptr; }
+    };
+
+    // cursor functions for paging through the tree without printing
+    Cursor Begin();
+    Cursor Seek(size_t position);
+    Cursor SeekKey(string bidId);
+    size_t Fetch(Cursor& cursor, size_t count, vector<Bid>& rows);
+
+private:
+
+    // helper function to move a cursor off the end of a leaf
+    static void skipToBid(Cursor& cursor);
+
+};
+
+/**
+ * Default constructor
+ */
+BidBPlusTree::BidBPlusTree() {
+
+    // an empty tree is a single empty leaf
+    root = new Leaf();
+    size = 0;
+    height = 1;
+}
+
+/**
+ * Destructor
+ */
+BidBPlusTree::~BidBPlusTree() {
+    clearTree(root);
+}
+
+/// <summary>
+/// Delete a node as the type it was created as
+/// </summary>
+/// <param name="node"></param>
+void BidBPlusTree::deleteNode(BNode* node) {
+    if (node->leaf) {
+        delete static_cast<Leaf*>(node);
+    }
+    else {
+        delete static_cast<Inner*>(node);
+    }
+}
+
+/// <summary>
+/// Helper function to delete every node below and including a node
+/// </summary>
+/// <param name="node"></param>
+void BidBPlusTree::clearTree(BNode* node) {
+    if (!node->leaf) {
+        Inner* inner = static_cast<Inner*>(node);
+        for (int i = 0; i <= inner->count; ++i) {
+            clearTree(inner->children[i]);
+        }
+    }
+    deleteNode(node);
+}
+
+/// <summary>
+/// Pack the first eight bytes of an id big-endian, padding short ids
+/// with zero bytes
+/// </summary>
+/// <param name="bidId"></param>
+/// <returns></returns>
+uint64_t BidBPlusTree::prefixOf(const string& bidId) {
+    uint64_t prefix = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        prefix <<= 8;
+        if (i < bidId.size()) {
+            prefix |= (unsigned char)bidId[i];
+        }
+    }
+    return prefix;
+}
+
+/// <summary>
+/// Index of the first key not less than key. Each step halves the range
+/// with a conditional move rather than a branch, so the loop runs the
+/// same number of times for every key and never mispredicts.
+/// </summary>
+/// <param name="keys"></param>
+/// <param name="count"></param>
+/// <param name="key"></param>
+/// <returns></returns>
+int BidBPlusTree::lowerBound(const uint64_t* keys, int count, uint64_t key) {
+    if (count == 0) {
+        return 0;
+    }
+
+    const uint64_t* base = keys;
+    while (count > 1) {
+        int half = count / 2;
+        base = (base[half] < key) ? base + half : base;
+        count -= half;
+    }
+    return (int)(base - keys) + (*base < key);
+}
+
+/// <summary>
+/// Index of the first key greater than key, searched the same way
+/// </summary>
+/// <param name="keys"></param>
+/// <param name="count"></param>
+/// <param name="key"></param>
+/// <returns></returns>
+int BidBPlusTree::upperBound(const uint64_t* keys, int count, uint64_t key) {
+    if (count == 0) {
+        return 0;
+    }
+
+    const uint64_t* base = keys;
+    while (count > 1) {
+        int half = count / 2;
+        base = (base[half] <= key) ? base + half : base;
+        count -= half;
+    }
+    return (int)(base - keys) + (*base <= key);
+}
+
+/// <summary>
+/// Slot of the first bid in a leaf whose id is not less than bidId
+/// </summary>
+/// <param name="leaf"></param>
+/// <param name="prefix"></param>
+/// <param name="bidId"></param>
+/// <returns></returns>
+int BidBPlusTree::leafSlot(const Leaf* leaf, uint64_t prefix, const string& bidId) {
+    int slot = lowerBound(leaf->keys, leaf->count, prefix);
+
+    // ids sharing a prefix are ordered by the rest of the id
+    while (slot < leaf->count && leaf->keys[slot] == prefix && leaf->bids[slot].bidId < bidId) {
+        ++slot;
+    }
+    return slot;
+}
+
+/// <summary>
+/// Index of the child of an inner node that covers bidId
+/// </summary>
+/// <param name="inner"></param>
+/// <param name="prefix"></param>
+/// <param name="bidId"></param>
+/// <returns></returns>
+int BidBPlusTree::childSlot(const Inner* inner, uint64_t prefix, const string& bidId) {
+    int slot = upperBound(inner->keys, inner->count, prefix);
+
+    // step back over separators that share the prefix but sort after the id
+    while (slot > 0 && inner->keys[slot - 1] == prefix && inner->ids[slot - 1] > bidId) {
+        --slot;
+    }
+    return slot;
+}
+
+/// <summary>
+/// Walk down to the leaf that covers bidId
+/// </summary>
+/// <param name="prefix"></param>
+/// <param name="bidId"></param>
+/// <returns></returns>
+BidBPlusTree::Leaf* BidBPlusTree::findLeaf(uint64_t prefix, const string& bidId) {
+    BNode* node = root;
+    while (!node->leaf) {
+        Inner* inner = static_cast<Inner*>(node);
+        node = inner->children[childSlot(inner, prefix, bidId)];
+    }
+    return static_cast<Leaf*>(node);
+}
+
+/// <summary>
+/// Returns the leaf holding the smallest ids
+/// </summary>
+/// <returns></returns>
+BidBPlusTree::Leaf* BidBPlusTree::firstLeaf() {
+    BNode* node = root;
+    while (!node->leaf) {
+        node = static_cast<Inner*>(node)->children[0];
+    }
+    return static_cast<Leaf*>(node);
+}
+
+/**
+ * Insert a bid
+ */
+void BidBPlusTree::Insert(Bid bid) {
+
+    uint64_t sepKey = 0;
+    string sepId;
+    bool added = false;
+    BNode* split = insertInto(root, bid, prefixOf(bid.bidId), sepKey, sepId, added);
+
+    // a split root gets a new root above it, the only way the tree grows taller
+    if (split != nullptr) {
+        Inner* newRoot = new Inner();
+        newRoot->keys[0] = sepKey;
+        newRoot->ids[0] = sepId;
+        newRoot->children[0] = root;
+        newRoot->children[1] = split;
+        newRoot->count = 1;
+        root = newRoot;
+        height += 1;
+    }
+
+    if (added) {
+        size += 1;
+    }
+}
+
+/**
+ * Add a bid below some node (recursive)
+ *
+ * @param node Current node in tree
+ * @param bid Bid to be added
+ * @param prefix key prefix of the bid id
+ * @param sepKey set to the separator prefix when the node splits
+ * @param sepId set to the separator id when the node splits
+ * @param added set to true when the bid was new rather than a replacement
+ * @return the new right sibling if the node split, otherwise nullptr
+ */
+BidBPlusTree::BNode* BidBPlusTree::insertInto(BNode* node, const Bid& bid, uint64_t prefix, uint64_t& sepKey, string& sepId, bool& added) {
+
+    if (node->leaf) {
+        Leaf* leaf = static_cast<Leaf*>(node);
+        int slot = leafSlot(leaf, prefix, bid.bidId);
+
+        // an existing id keeps its place and takes the new bid
+        if (slot < leaf->count && leaf->keys[slot] == prefix && leaf->bids[slot].bidId == bid.bidId) {
+            leaf->bids[slot] = bid;
+            return nullptr;
+        }
+
+        // open a slot for the bid
+        for (int i = leaf->count; i > slot; --i) {
+            leaf->keys[i] = leaf->keys[i - 1];
+            leaf->bids[i] = move(leaf->bids[i - 1]);
+        }
+        leaf->keys[slot] = prefix;
+        leaf->bids[slot] = bid;
+        leaf->count += 1;
+        added = true;
+
+        if (leaf->count <= BPTREE_MAX_KEYS) {
+            return nullptr;
+        }
+
+        // move the upper half into a new leaf; its first id separates them
+        Leaf* right = new Leaf();
+        int half = leaf->count / 2;
+        for (int i = half; i < leaf->count; ++i) {
+            right->keys[i - half] = leaf->keys[i];
+            right->bids[i - half] = move(leaf->bids[i]);
+        }
+        right->count = leaf->count - half;
+        leaf->count = half;
+
+        right->next = leaf->next;
+        leaf->next = right;
+
+        sepKey = right->keys[0];
+        sepId = right->bids[0].bidId;
+        return right;
+    }
+
+    Inner* inner = static_cast<Inner*>(node);
+    int index = childSlot(inner, prefix, bid.bidId);
+
+    uint64_t childKey = 0;
+    string childId;
+    BNode* split = insertInto(inner->children[index], bid, prefix, childKey, childId, added);
+    if (split == nullptr) {
+        return nullptr;
+    }
+
+    // add the separator and the new child just after the child that split
+    for (int i = inner->count; i > index; --i) {
+        inner->keys[i] = inner->keys[i - 1];
+        inner->ids[i] = move(inner->ids[i - 1]);
+        inner->children[i + 1] = inner->children[i];
+    }
+    inner->keys[index] = childKey;
+    inner->ids[index] = move(childId);
+    inner->children[index + 1] = split;
+    inner->count += 1;
+
+    if (inner->count <= BPTREE_MAX_KEYS) {
+        return nullptr;
+    }
+
+    // move the upper half into a new inner node; the middle separator
+    // moves up to the parent
+    Inner* right = new Inner();
+    int half = inner->count / 2;
+    sepKey = inner->keys[half];
+    sepId = move(inner->ids[half]);
+    for (int i = half + 1; i < inner->count; ++i) {
+        right->keys[i - half - 1] = inner->keys[i];
+        right->ids[i - half - 1] = move(inner->ids[i]);
+    }
+    for (int i = half + 1; i <= inner->count; ++i) {
+        right->children[i - half - 1] = inner->children[i];
+    }
+    right->count = inner->count - half - 1;
+    inner->count = half;
+    return right;
+}
+
+/// <summary>
+/// Public function to remove a bid
+/// </summary>
+/// <param name="bidId"></param>
+void BidBPlusTree::removeRecur(string bidId) {
+
+    if (!removeFrom(root, prefixOf(bidId), bidId)) {
+        return;
+    }
+    size -= 1;
+
+    // a root left with a single child hands the root over to it
+    if (!root->leaf && root->count == 0) {
+        Inner* oldRoot = static_cast<Inner*>(root);
+        root = oldRoot->children[0];
+        delete oldRoot;
+        height -= 1;
+    }
+}
+
+/// <summary>
+/// Remove a bid below some node (recursive). A child left with too few
+/// keys is refilled from a sibling or merged with one on the way back up.
+/// </summary>
+/// <param name="node"></param>
+/// <param name="prefix"></param>
+/// <param name="bidId"></param>
+/// <returns>true if the bid was found and removed</returns>
+bool BidBPlusTree::removeFrom(BNode* node, uint64_t prefix, const string& bidId) {
+
+    if (node->leaf) {
+        Leaf* leaf = static_cast<Leaf*>(node);
+        int slot = leafSlot(leaf, prefix, bidId);
+        if (slot == leaf->count || leaf->keys[slot] != prefix || leaf->bids[slot].bidId != bidId) {
+            return false;
+        }
+
+        // close the gap; separators above may still name the removed id,
+        // which is fine since they only need to bound the ids below them
+        for (int i = slot + 1; i < leaf->count; ++i) {
+            leaf->keys[i - 1] = leaf->keys[i];
+            leaf->bids[i - 1] = move(leaf->bids[i]);
+        }
+        leaf->count -= 1;
+        leaf->bids[leaf->count] = Bid();
+        return true;
+    }
+
+    Inner* inner = static_cast<Inner*>(node);
+    int index = childSlot(inner, prefix, bidId);
+    if (!removeFrom(inner->children[index], prefix, bidId)) {
+        return false;
+    }
+
+    if (inner->children[index]->count < BPTREE_MIN_KEYS) {
+        fixUnderflow(inner, index);
+    }
+    return true;
+}
+
+/// <summary>
+/// Refill a child that fell below the minimum by borrowing a key from
+/// a sibling with keys to spare, or else merge it with a sibling
+/// </summary>
+/// <param name="parent"></param>
+/// <param name="index">index of the child in parent</param>
+void BidBPlusTree::fixUnderflow(Inner* parent, int index) {
+
+    BNode* child = parent->children[index];
+    BNode* left = index > 0 ? parent->children[index - 1] : nullptr;
+    BNode* right = index < parent->count ? parent->children[index + 1] : nullptr;
+
+    // take the last key of the left sibling
+    if (left != nullptr && left->count > BPTREE_MIN_KEYS) {
+        for (int i = child->count; i > 0; --i) {
+            child->keys[i] = child->keys[i - 1];
+        }
+
+        if (child->leaf) {
+            Leaf* leafChild = static_cast<Leaf*>(child);
+            Leaf* leafLeft = static_cast<Leaf*>(left);
+            for (int i = child->count; i > 0; --i) {
+                leafChild->bids[i] = move(leafChild->bids[i - 1]);
+            }
+            leafChild->keys[0] = leafLeft->keys[left->count - 1];
+            leafChild->bids[0] = move(leafLeft->bids[left->count - 1]);
+
+            // the moved bid is now the first id of the child
+            parent->keys[index - 1] = leafChild->keys[0];
+            parent->ids[index - 1] = leafChild->bids[0].bidId;
+        }
+        else {
+            Inner* innerChild = static_cast<Inner*>(child);
+            Inner* innerLeft = static_cast<Inner*>(left);
+            for (int i = child->count; i > 0; --i) {
+                innerChild->ids[i] = move(innerChild->ids[i - 1]);
+            }
+            for (int i = child->count + 1; i > 0; --i) {
+                innerChild->children[i] = innerChild->children[i - 1];
+            }
+
+            // rotate through the parent: its separator comes down and
+            // the left sibling's last separator goes up
+            innerChild->keys[0] = parent->keys[index - 1];
+            innerChild->ids[0] = move(parent->ids[index - 1]);
+            innerChild->children[0] = innerLeft->children[left->count];
+            parent->keys[index - 1] = innerLeft->keys[left->count - 1];
+            parent->ids[index - 1] = move(innerLeft->ids[left->count - 1]);
+        }
+
+        left->count -= 1;
+        child->count += 1;
+    }
+
+    // take the first key of the right sibling
+    else if (right != nullptr && right->count > BPTREE_MIN_KEYS) {
+        if (child->leaf) {
+            Leaf* leafChild = static_cast<Leaf*>(child);
+            Leaf* leafRight = static_cast<Leaf*>(right);
+            leafChild->keys[child->count] = leafRight->keys[0];
+            leafChild->bids[child->count] = move(leafRight->bids[0]);
+            for (int i = 1; i < right->count; ++i) {
+                leafRight->keys[i - 1] = leafRight->keys[i];
+                leafRight->bids[i - 1] = move(leafRight->bids[i]);
+            }
+            leafRight->bids[right->count - 1] = Bid();
+
+            // the right sibling starts at a new id
+            parent->keys[index] = leafRight->keys[0];
+            parent->ids[index] = leafRight->bids[0].bidId;
+        }
+        else {
+            Inner* innerChild = static_cast<Inner*>(child);
+            Inner* innerRight = static_cast<Inner*>(right);
+            innerChild->keys[child->count] = parent->keys[index];
+            innerChild->ids[child->count] = move(parent->ids[index]);
+            innerChild->children[child->count + 1] = innerRight->children[0];
+            parent->keys[index] = innerRight->keys[0];
+            parent->ids[index] = move(innerRight->ids[0]);
+
+            for (int i = 1; i < right->count; ++i) {
+                innerRight->keys[i - 1] = innerRight->keys[i];
+                innerRight->ids[i - 1] = move(innerRight->ids[i]);
+            }
+            for (int i = 1; i <= right->count; ++i) {
+                innerRight->children[i - 1] = innerRight->children[i];
+            }
+        }
+
+        right->count -= 1;
+        child->count += 1;
+    }
+
+    // neither sibling can spare a key, so two nodes become one
+    else if (left != nullptr) {
+        mergeChildren(parent, index - 1);
+    }
+    else {
+        mergeChildren(parent, index);
+    }
+}
+
+/// <summary>
+/// Merge the child after index into the child at index and drop the
+/// separator between them from the parent
+/// </summary>
+/// <param name="parent"></param>
+/// <param name="index"></param>
+void BidBPlusTree::mergeChildren(Inner* parent, int index) {
+
+    BNode* left = parent->children[index];
+    BNode* right = parent->children[index + 1];
+
+    if (left->leaf) {
+        Leaf* leafLeft = static_cast<Leaf*>(left);
+        Leaf* leafRight = static_cast<Leaf*>(right);
+        for (int i = 0; i < right->count; ++i) {
+            leafLeft->keys[left->count + i] = leafRight->keys[i];
+            leafLeft->bids[left->count + i] = move(leafRight->bids[i]);
+        }
+        left->count += right->count;
+        leafLeft->next = leafRight->next;
+        delete leafRight;
+    }
+    else {
+        Inner* innerLeft = static_cast<Inner*>(left);
+        Inner* innerRight = static_cast<Inner*>(right);
+
+        // the parent's separator sits between the two halves
+        innerLeft->keys[left->count] = parent->keys[index];
+        innerLeft->ids[left->count] = move(parent->ids[index]);
+        for (int i = 0; i < right->count; ++i) {
+            innerLeft->keys[left->count + 1 + i] = innerRight->keys[i];
+            innerLeft->ids[left->count + 1 + i] = move(innerRight->ids[i]);
+        }
+        for (int i = 0; i <= right->count; ++i) {
+            innerLeft->children[left->count + 1 + i] = innerRight->children[i];
+        }
+        left->count += 1 + right->count;
+        delete innerRight;
+    }
+
+    // close the gap in the parent
+    for (int i = index + 1; i < parent->count; ++i) {
+        parent->keys[i - 1] = parent->keys[i];
+        parent->ids[i - 1] = move(parent->ids[i]);
+        parent->children[i] = parent->children[i + 1];
+    }
+    parent->count -= 1;
+    parent->ids[parent->count].clear();
+}
+
+/// <summary>
+/// Public accessible search function
+/// </summary>
+/// <param name="bidId"></param>
+/// <returns>the stored bid, or nullptr if the id is not in the tree</returns>
+Bid* BidBPlusTree::SearchA(string bidId) {
+
+    uint64_t prefix = prefixOf(bidId);
+    Leaf* leaf = findLeaf(prefix, bidId);
+    int slot = leafSlot(leaf, prefix, bidId);
+
+    if (slot < leaf->count && leaf->keys[slot] == prefix && leaf->bids[slot].bidId == bidId) {
+        return &leaf->bids[slot];
+    }
+    return nullptr;
+}
+
+/**
+ * Traverse the tree in order
+ */
+void BidBPlusTree::InOrder() {
+
+    // the linked leaves already hold the bids in order
+    for (Leaf* leaf = firstLeaf(); leaf != nullptr; leaf = leaf->next) {
+        for (int i = 0; i < leaf->count; ++i) {
+            const Bid& bid = leaf->bids[i];
+            cout << bid.bidId << ": " << bid.title << ", "
+                << bid.fund << ", " << bid.amount << "\n";
+        }
+    }
+}
+
+// function to get size of tree (kept as a running count)
+size_t BidBPlusTree::GetSize() {
+    return size;
+}
+
+// function to get the number of levels in the tree
+int BidBPlusTree::GetHeight() {
+    return height;
+}
+
+/// <summary>
+/// Move a cursor that sits past the last bid of its leaf to the first
+/// bid of the next non-empty leaf, or to the end
+/// </summary>
+/// <param name="cursor"></param>
+void BidBPlusTree::skipToBid(Cursor& cursor) {
+    while (cursor.leaf != nullptr && cursor.slot >= cursor.leaf->count) {
+        cursor.leaf = cursor.leaf->next;
+        cursor.slot = 0;
+    }
+}
+
+/// <summary>
+/// Returns a cursor at the smallest bid id in the tree
+/// </summary>
+/// <returns></returns>
+BidBPlusTree::Cursor BidBPlusTree::Begin() {
+    Cursor cursor;
+    cursor.leaf = firstLeaf();
+    skipToBid(cursor);
+    return cursor;
+}
+
+/// <summary>
+/// Returns a cursor at the given in-order position. Whole leaves are
+/// skipped by their counts, so this reads one key count per leaf.
+/// </summary>
+/// <param name="position"></param>
+/// <returns></returns>
+BidBPlusTree::Cursor BidBPlusTree::Seek(size_t position) {
+
+    Cursor cursor;
+    cursor.leaf = firstLeaf();
+    while (cursor.leaf != nullptr && position >= (size_t)cursor.leaf->count) {
+        position -= cursor.leaf->count;
+        cursor.leaf = cursor.leaf->next;
+    }
+    cursor.slot = (int)position;
+    return cursor;
+}
+
+/// <summary>
+/// Returns a cursor at the first bid whose id is not less than bidId
+/// </summary>
+/// <param name="bidId"></param>
+/// <returns></returns>
+BidBPlusTree::Cursor BidBPlusTree::SeekKey(string bidId) {
+
+    uint64_t prefix = prefixOf(bidId);
+    Cursor cursor;
+    cursor.leaf = findLeaf(prefix, bidId);
+    cursor.slot = leafSlot(cursor.leaf, prefix, bidId);
+    skipToBid(cursor);
+    return cursor;
+}
+
+/// <summary>
+/// Copy up to count bids in order starting at the cursor and move the
+/// cursor past them, so the next call resumes where this one stopped
+/// </summary>
+/// <param name="cursor"></param>
+/// <param name="count"></param>
+/// <param name="rows"></param>
+/// <returns>number of bids appended to rows</returns>
+size_t BidBPlusTree::Fetch(Cursor& cursor, size_t count, vector<Bid>& rows) {
+
+    size_t fetched = 0;
+    while (cursor.leaf != nullptr && fetched < count) {
+        rows.push_back(cursor.leaf->bids[cursor.slot]);
+        ++fetched;
+
+        cursor.slot += 1;
+        skipToBid(cursor);
+    }
+
+    return fetched;
+}
+
 //============================================================================
 // Static methods used for testing
 //============================================================================
@@ -554,9 +1644,11 @@ void displayBid(Bid bid) {
  * Load a CSV file containing bids into a container
  *
  * @param csvPath the path to the CSV file to load
+ * @param filter filter over loaded ids; rows with an id already in the
+ *               tree are skipped, and most rows never search the tree
  * @return a container holding all the bids read
  */
-void loadBids(string csvPath, BinarySearchTree* bst) {
+void loadBids(string csvPath, BinarySearchTree* bst, BidBloomFilter* filter) {
     cout << "Loading CSV file " << csvPath << endl;
 
     // initialize the CSV Parser using the given path
@@ -569,6 +1661,9 @@ void loadBids(string csvPath, BinarySearchTree* bst) {
     }
     cout << "" << endl;
 
+    // size the filter for the rows about to be loaded
+    filter->Reserve(file.rowCount());
+
     try {
         // loop to read rows of a CSV file
         for (unsigned int i = 0; i < file.rowCount(); i++) {
@@ -580,6 +1675,12 @@ void loadBids(string csvPath, BinarySearchTree* bst) {
             bid.fund = file[i][8];
             bid.amount = strToDouble(file[i][4], '$');
 
+            // skip duplicate ids; only a possible hit needs a real search
+            if (filter->MightContain(bid.bidId) && bst->SearchA(bid.bidId) != nullptr) {
+                continue;
+            }
+            filter->Add(bid.bidId);
+
             cout << "Bid: " << bid.bidId << ", Title: " << bid.title << ", Fund: " << bid.fund << ", Amount: " << bid.amount << endl;
 
             // push this bid to the end
@@ -593,6 +1694,81 @@ void loadBids(string csvPath, BinarySearchTree* bst) {
     }
 }
 
+/**
+ * Copy the loaded bids into a B+ tree, then time searching every bid
+ * in random order and scanning every bid in order in both trees
+ *
+ * @param bst the tree holding the loaded bids
+ */
+void compareTreeSearch(BinarySearchTree* bst) {
+
+    vector<Bid> bids;
+    BinarySearchTree::Cursor treeCursor = bst->Begin();
+    bst->Fetch(treeCursor, bst->GetSize(), bids);
+    if (bids.empty()) {
+        cout << "Load bids before comparing the trees.\n";
+        return;
+    }
+
+    clock_t ticks = clock();
+    BidBPlusTree bplus;
+    for (const Bid& bid : bids) {
+        bplus.Insert(bid);
+    }
+    ticks = clock() - ticks;
+    cout << "\nB+ tree built from " << bplus.GetSize() << " bids in "
+        << ticks * 1.0 / CLOCKS_PER_SEC << " seconds\n";
+
+    // the binary search tree keeps every bid it is given, while the
+    // B+ tree keeps one bid per id and replaces a repeated id
+    if (bplus.GetSize() != bids.size()) {
+        cout << bids.size() - bplus.GetSize() << " bids repeat an id; the binary search tree keeps all "
+            << bids.size() << ", the B+ tree keeps one bid per id\n";
+    }
+
+    // search in an order unrelated to how either tree is laid out
+    vector<string> ids;
+    for (const Bid& bid : bids) {
+        ids.push_back(bid.bidId);
+    }
+    shuffle(ids.begin(), ids.end(), mt19937(42));
+
+    size_t found = 0;
+    ticks = clock();
+    for (const string& id : ids) {
+        found += bst->SearchA(id) != nullptr;
+    }
+    clock_t treeSearch = clock() - ticks;
+
+    size_t bplusFound = 0;
+    ticks = clock();
+    for (const string& id : ids) {
+        bplusFound += bplus.SearchA(id) != nullptr;
+    }
+    clock_t bplusSearch = clock() - ticks;
+
+    // page through every bid in order
+    vector<Bid> rows;
+    rows.reserve(bids.size());
+    ticks = clock();
+    treeCursor = bst->Begin();
+    bst->Fetch(treeCursor, bids.size(), rows);
+    clock_t treeScan = clock() - ticks;
+
+    rows.clear();
+    ticks = clock();
+    BidBPlusTree::Cursor bplusCursor = bplus.Begin();
+    bplus.Fetch(bplusCursor, bids.size(), rows);
+    clock_t bplusScan = clock() - ticks;
+
+    cout << "binary search tree: height " << bst->GetHeight() << ", " << found << " found, "
+        << treeSearch * 1e9 / CLOCKS_PER_SEC / ids.size() << " ns per search, "
+        << treeScan * 1.0 / CLOCKS_PER_SEC << " seconds to scan\n";
+    cout << "B+ tree:            height " << bplus.GetHeight() << ", " << bplusFound << " found, "
+        << bplusSearch * 1e9 / CLOCKS_PER_SEC / ids.size() << " ns per search, "
+        << bplusScan * 1.0 / CLOCKS_PER_SEC << " seconds to scan\n";
+}
+
 /**
  * Simple C function to convert a string to a double
  * after stripping out unwanted char
@@ -633,7 +1809,7 @@ int main(int argc, char* argv[]) {
 
     // Define a binary search tree to hold all bids
     BinarySearchTree* bst;
-    bst = new BinarySearchTree();
+    bst = new BinarySearchTree(true);
 
     Bid bid;
     Bid searchBid;
@@ -641,6 +1817,18 @@ int main(int argc, char* argv[]) {
     Node* temp = nullptr;
     string input{};
 
+    // filter over loaded ids for fast duplicate checks
+    BidBloomFilter bidFilter;
+
+    // paging position kept between menu actions, so the next page carries
+    // on from the cursor instead of seeking from the smallest id. Inserts
+    // and removes can rotate or free nodes the cursor holds, so changes
+    // mark it stale and the next page seeks to its position again.
+    const size_t pageSize = 20;
+    BinarySearchTree::Cursor pageCursor;
+    int pageNumber = 0;
+    bool pageCursorValid = false;
+
     int choice = 0;
     while (choice != 9) {
         cout << "\nMenu:" << endl;
@@ -651,6 +1839,9 @@ int main(int argc, char* argv[]) {
         cout << "  5. Find Bid" << endl;
         cout << "  6. Add Bid" << endl;
         cout << "  7. Remove Bid" << endl;
+        cout << "  8. Display a Page of Bids" << endl;
+        cout << " 10. Compare Search with a B+ Tree" << endl;
+        cout << " 11. Display the Next Page of Bids" << endl;
         cout << "  9. Exit" << endl;
         cout << "Enter choice: ";
         cin >> choice;
@@ -663,7 +1854,8 @@ int main(int argc, char* argv[]) {
             ticks = clock();
 
             // Complete the method call to load the bids
-            loadBids(csvPath, bst);
+            loadBids(csvPath, bst, &bidFilter);
+            pageCursorValid = false;
 
             // Calculate elapsed time and display result
             ticks = clock() - ticks; // current clock ticks minus starting clock ticks
@@ -766,8 +1958,12 @@ int main(int argc, char* argv[]) {
             // get input from user to fill in data for the new bid
             bid = getBid();
 
-            // create a temp bid to search for the bidId
-            temp = bst->SearchA(bid.bidId);
+            // create a temp bid to search for the bidId;
+            // the filter answers "definitely new" without a search
+            temp = nullptr;
+            if (bidFilter.MightContain(bid.bidId)) {
+                temp = bst->SearchA(bid.bidId);
+            }
 
             // if the bidid already exists, then inform user and prevent adding the node
             if (temp != nullptr) {
@@ -781,6 +1977,8 @@ int main(int argc, char* argv[]) {
 
                 // call insert function to add the bid
                 bst->Insert(bid);
+                bidFilter.Add(bid.bidId);
+                pageCursorValid = false;
                 
                 // Calculate elapsed time and display result
                 ticks = clock() - ticks; // current clock ticks minus starting clock ticks
@@ -819,6 +2017,7 @@ int main(int argc, char* argv[]) {
 
                 // call remove function
                 bst->removeRecur(input);
+                pageCursorValid = false;
 
                 // Calculate elapsed time and display result
                 ticks = clock() - ticks; // current clock ticks minus starting clock ticks
@@ -829,6 +2028,78 @@ int main(int argc, char* argv[]) {
 
             }
 
+            break;
+
+        // display one page of bids in order using a tree cursor
+        case 8:
+
+            cout << "\n\nEnter the page number: ";
+            cin >> input;
+
+            {
+                int page = max(1, atoi(input.c_str()));
+                vector<Bid> rows;
+
+                // Initialize a timer variable before paging
+                ticks = clock();
+
+                pageCursor = bst->Seek((page - 1) * pageSize);
+                bst->Fetch(pageCursor, pageSize, rows);
+                pageNumber = page;
+                pageCursorValid = true;
+
+                // Calculate elapsed time and display result
+                ticks = clock() - ticks; // current clock ticks minus starting clock ticks
+
+                cout << "\nPage " << page << ":\n";
+                for (const Bid& row : rows) {
+                    displayBid(row);
+                }
+                cout << "time: " << ticks << " clock ticks" << endl;
+                cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+            }
+
+            break;
+
+        // time searches and scans against a B+ tree built from the same bids
+        case 10:
+
+            compareTreeSearch(bst);
+
+            break;
+
+        // display the page after the last one shown, resuming from the saved cursor
+        case 11:
+
+            {
+                vector<Bid> rows;
+
+                // Initialize a timer variable before paging
+                ticks = clock();
+
+                if (!pageCursorValid) {
+                    pageCursor = bst->Seek(pageNumber * pageSize);
+                    pageCursorValid = true;
+                }
+                bst->Fetch(pageCursor, pageSize, rows);
+
+                // Calculate elapsed time and display result
+                ticks = clock() - ticks; // current clock ticks minus starting clock ticks
+
+                if (rows.empty()) {
+                    cout << "\nNo more bids." << endl;
+                    break;
+                }
+                pageNumber += 1;
+
+                cout << "\nPage " << pageNumber << ":\n";
+                for (const Bid& row : rows) {
+                    displayBid(row);
+                }
+                cout << "time: " << ticks << " clock ticks" << endl;
+                cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+            }
+
             break;
         }
     }
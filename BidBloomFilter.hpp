@@ -0,0 +1,152 @@
+//============================================================================
+// Name        : BidBloomFilter.hpp
+// Author      : Chris Trimmer
+// Version     : 1.0
+// Description : Blocked Bloom filter over bid ids, shared by the
+//               list, hash table and tree programs
+//============================================================================
+
+#ifndef BIDBLOOMFILTER_HPP
+#define BIDBLOOMFILTER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Define a class containing data members and methods to implement a
+ * blocked Bloom filter over bid ids.
+ *
+ * Every key sets its bits inside a single 64-byte block, so a lookup
+ * touches one cache line. MightContain returning false means the id has
+ * definitely never been added, so the container does not need to be
+ * searched; true means the caller must fall back to a real lookup.
+ * Ids cannot be removed, so removing a bid only leaves a stale bit
+ * pattern that costs an occasional extra lookup.
+ */
+class BidBloomFilter {
+
+private:
+    // one cache line of filter bits
+    struct alignas(64) Block {
+        uint64_t words[8];
+    };
+
+    // bits reserved per expected key (about 1% false positives)
+    static const size_t BITS_PER_KEY = 10;
+
+    // number of bits set per key inside its block
+    static const int HASHES_PER_KEY = 6;
+
+    std::vector<Block> blocks;
+    size_t count = 0;
+
+    /**
+     * 64-bit FNV-1a hash of the id, finished with a bit mixer so
+     * every output bit depends on every input byte
+     */
+    static uint64_t hashKey(const std::string& bidId) {
+        uint64_t h = 14695981039346656037ULL;
+        for (unsigned char c : bidId) {
+            h ^= c;
+            h *= 1099511628211ULL;
+        }
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // map the high half of the hash onto a block without a division
+    Block& blockFor(uint64_t h) {
+        return blocks[((h >> 32) * blocks.size()) >> 32];
+    }
+    const Block& blockFor(uint64_t h) const {
+        return blocks[((h >> 32) * blocks.size()) >> 32];
+    }
+
+public:
+    /**
+     * Constructor
+     *
+     * @param expectedKeys number of ids the filter is sized for
+     */
+    explicit BidBloomFilter(size_t expectedKeys = 100000) {
+        Reserve(expectedKeys);
+    }
+
+    /**
+     * Size the filter for a number of ids. A filter that already holds
+     * ids keeps its size, since the ids can't be rehashed; it stays
+     * correct but its false positive rate climbs.
+     */
+    void Reserve(size_t expectedKeys) {
+        if (count != 0 && !blocks.empty()) {
+            return;
+        }
+
+        size_t blockCount = (expectedKeys * BITS_PER_KEY + 511) / 512;
+        if (blockCount == 0) {
+            blockCount = 1;
+        }
+        if (blockCount > blocks.size()) {
+            blocks.assign(blockCount, Block());
+        }
+    }
+
+    /**
+     * Record an id in the filter
+     */
+    void Add(const std::string& bidId) {
+        uint64_t h = hashKey(bidId);
+        Block& block = blockFor(h);
+
+        // each 9-bit slice of the low half picks a bit within the block
+        uint64_t bits = h * 0x9e3779b97f4a7c15ULL;
+        for (int i = 0; i < HASHES_PER_KEY; ++i) {
+            unsigned bit = bits & 511;
+            block.words[bit >> 6] |= uint64_t(1) << (bit & 63);
+            bits >>= 9;
+        }
+        ++count;
+    }
+
+    /**
+     * Test whether an id may have been added
+     *
+     * @return false if the id is definitely new
+     */
+    bool MightContain(const std::string& bidId) const {
+        uint64_t h = hashKey(bidId);
+        const Block& block = blockFor(h);
+
+        uint64_t bits = h * 0x9e3779b97f4a7c15ULL;
+        for (int i = 0; i < HASHES_PER_KEY; ++i) {
+            unsigned bit = bits & 511;
+            if ((block.words[bit >> 6] & (uint64_t(1) << (bit & 63))) == 0) {
+                return false;
+            }
+            bits >>= 9;
+        }
+        return true;
+    }
+
+    /**
+     * Forget every id
+     */
+    void Clear() {
+        blocks.assign(blocks.size(), Block());
+        count = 0;
+    }
+
+    /**
+     * Returns the number of ids added
+     */
+    size_t Count() const {
+        return count;
+    }
+};
+
+#endif // BIDBLOOMFILTER_HPP
@@ -0,0 +1,239 @@
+//============================================================================
+// Name        : EpochReclamation.hpp
+// Author      : Chris Trimmer
+// Version     : 1.0
+// Description : Epoch-based reclamation for the lock-free containers in
+//               the list and hash table programs
+//============================================================================
+
+#ifndef EPOCHRECLAMATION_HPP
+#define EPOCHRECLAMATION_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// maximum number of threads that can use the reclaimers at the same time
+const int EPOCH_MAX_THREADS = 64;
+
+// marks a participant slot that is not inside a critical region
+const uint64_t EPOCH_QUIESCENT = UINT64_MAX;
+
+/**
+ * Define a class that defers freeing unlinked nodes until no thread can
+ * still be reading them. A thread pins the current epoch for the length
+ * of an operation; retired nodes are tagged with the global epoch at the
+ * moment they are retired and freed once it has advanced twice past that.
+ * The global epoch only advances when every pinned thread has seen it,
+ * so reaching tag + 2 means every thread pinned before the retire has
+ * since left its critical region.
+ */
+class EpochReclaimer {
+
+private:
+    // a retired object and the function that frees it
+    struct Retired {
+        void* object;
+        void (*deleter)(void*);
+    };
+
+    // per-thread slot, padded to its own cache line; only the owning
+    // thread writes it, so pinning never bounces a line between readers
+    struct alignas(64) Participant {
+        std::atomic<uint64_t> epoch{EPOCH_QUIESCENT};
+        unsigned depth = 0;
+        std::vector<Retired> limbo[3];
+        uint64_t limboEpoch[3] = {0, 0, 0};
+    };
+
+    std::atomic<uint64_t> globalEpoch{0};
+    Participant participants[EPOCH_MAX_THREADS];
+
+    static unsigned threadIndex();
+    void tryAdvance();
+    void collect(Participant* self, uint64_t epoch);
+
+public:
+    /**
+     * RAII handle that keeps a thread pinned to an epoch
+     */
+    class Guard {
+        friend class EpochReclaimer;
+        EpochReclaimer* owner;
+        Participant* slot;
+        Guard(EpochReclaimer* anOwner, Participant* aSlot) : owner(anOwner), slot(aSlot) {}
+    public:
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard(Guard&& other) noexcept : owner(other.owner), slot(other.slot) {
+            other.slot = nullptr;
+        }
+        ~Guard();
+        void Retire(void* object, void (*deleter)(void*));
+    };
+
+    EpochReclaimer() {}
+    EpochReclaimer(const EpochReclaimer&) = delete;
+    EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+    virtual ~EpochReclaimer();
+
+    Guard Pin();
+};
+
+/**
+ * Destructor
+ * No thread may be pinned, so everything still in limbo can be freed.
+ */
+inline EpochReclaimer::~EpochReclaimer() {
+    for (Participant& p : participants) {
+        for (std::vector<Retired>& bucket : p.limbo) {
+            for (Retired& r : bucket) {
+                r.deleter(r.object);
+            }
+            bucket.clear();
+        }
+    }
+}
+
+/**
+ * Returns the calling thread's participant index. A thread claims an
+ * index the first time it pins and keeps it, in every reclaimer, until
+ * it exits. Throws if EPOCH_MAX_THREADS live threads already hold one.
+ */
+inline unsigned EpochReclaimer::threadIndex() {
+
+    // one flag per index, shared by every reclaimer
+    static std::atomic<bool> taken[EPOCH_MAX_THREADS];
+
+    struct Registration {
+        unsigned index = 0;
+
+        Registration() {
+            for (int i = 0; i < EPOCH_MAX_THREADS; ++i) {
+                bool expected = false;
+                if (!taken[i].load(std::memory_order_relaxed) &&
+                    taken[i].compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    index = (unsigned)i;
+                    return;
+                }
+            }
+
+            // every index belongs to a live thread; waiting for one to
+            // exit could spin forever, so refuse the extra thread
+            throw std::runtime_error("EpochReclaimer: more than EPOCH_MAX_THREADS threads");
+        }
+
+        ~Registration() {
+            taken[index].store(false, std::memory_order_release);
+        }
+    };
+
+    thread_local Registration registration;
+    return registration.index;
+}
+
+/**
+ * Enter a critical region by publishing the epoch in this thread's slot
+ *
+ * @return guard that leaves the region when destroyed
+ */
+inline EpochReclaimer::Guard EpochReclaimer::Pin() {
+
+    Participant& p = participants[threadIndex()];
+
+    // a nested pin keeps the epoch of the outer one
+    if (p.depth++ == 0) {
+
+        // publish the epoch before reading any shared node, then check
+        // it is still current; an epoch published after the global one
+        // moved on would let objects this thread can reach be freed
+        uint64_t epoch = globalEpoch.load();
+        for (;;) {
+            p.epoch.store(epoch, std::memory_order_seq_cst);
+            uint64_t current = globalEpoch.load();
+            if (current == epoch) {
+                break;
+            }
+            epoch = current;
+        }
+    }
+    return Guard(this, &p);
+}
+
+/**
+ * Leave the critical region once the outermost guard goes away
+ */
+inline EpochReclaimer::Guard::~Guard() {
+    if (slot == nullptr) {
+        return;
+    }
+
+    if (--slot->depth == 0) {
+        slot->epoch.store(EPOCH_QUIESCENT, std::memory_order_release);
+    }
+}
+
+/**
+ * Hand an unlinked object to the reclaimer
+ *
+ * @param object the object that is no longer reachable
+ * @param deleter function that frees the object
+ */
+inline void EpochReclaimer::Guard::Retire(void* object, void (*deleter)(void*)) {
+
+    // tag with the global epoch, not the pinned one; the global epoch may
+    // already be one ahead, and readers pinned there can reach the object
+    uint64_t epoch = owner->globalEpoch.load();
+    int bucket = epoch % 3;
+
+    // the bucket may still hold objects from three epochs ago
+    if (slot->limboEpoch[bucket] != epoch) {
+        owner->collect(slot, epoch);
+        slot->limboEpoch[bucket] = epoch;
+    }
+    slot->limbo[bucket].push_back({ object, deleter });
+
+    // try to move the epoch forward every so often
+    if (slot->limbo[bucket].size() % 64 == 0) {
+        owner->tryAdvance();
+        owner->collect(slot, owner->globalEpoch.load());
+    }
+}
+
+/**
+ * Advance the global epoch if every pinned thread has seen it
+ */
+inline void EpochReclaimer::tryAdvance() {
+
+    uint64_t current = globalEpoch.load();
+
+    for (Participant& p : participants) {
+        uint64_t epoch = p.epoch.load();
+        if (epoch != EPOCH_QUIESCENT && epoch != current) {
+            return;
+        }
+    }
+
+    globalEpoch.compare_exchange_strong(current, current + 1);
+}
+
+/**
+ * Free the objects in a slot that were retired at least two epochs
+ * before the given one
+ *
+ * @param self slot owned by the calling thread
+ * @param epoch the newest epoch the caller has observed
+ */
+inline void EpochReclaimer::collect(Participant* self, uint64_t epoch) {
+    for (int i = 0; i < 3; ++i) {
+        if (!self->limbo[i].empty() && self->limboEpoch[i] + 2 <= epoch) {
+            for (Retired& r : self->limbo[i]) {
+                r.deleter(r.object);
+            }
+            self->limbo[i].clear();
+        }
+    }
+}
+
+#endif // EPOCHRECLAMATION_HPP